@@ -0,0 +1,255 @@
+/*
+ *  Re2.Net Copyright © 2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Re2.Net/Regex.h for licensing and contact information.
+ */
+
+/*
+ *  Times the encoding kernels of Re2.Net, and RE2 itself, outside the CLR, so that a change to
+ *  a kernel can be measured on its own. See CMakeLists.txt for building.
+ *
+ *      re2net-benchmark [corpus] [repeats]
+ *
+ *  corpus is a single-byte text file, such as the mtent12.txt read by Re2.Net.Test. Every test
+ *  is also run over synthetic ASCII, Latin-1, CJK, and astral (surrogate pair) inputs.
+ *
+ *  Each kernel is timed over the whole input, and the best of repeats runs is reported. Bytes
+ *  are those the kernel reads: two per char for the UTF-16 kernels, and the UTF-8 size for
+ *  StrToCharPos, CharToStrPos, and RE2.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <re2/re2.h>
+
+#include "StringEncoding.h"
+
+
+using namespace Re2::Net;
+
+static_assert(sizeof(wchar_t) == 2, "wchar_t must be a UTF-16 code unit. Build with -fshort-wchar.");
+
+
+namespace
+{
+    /* Keeps the results of the kernels alive, so that their loops aren't optimized away. */
+    volatile long long sink;
+
+
+    struct Input
+    {
+        std::string          name;
+        std::vector<wchar_t> chars;
+        std::string          utf8;
+    };
+
+
+    /* Runs f repeats times and returns the fastest run, in nanoseconds. */
+    template<typename F>
+    static double best(int repeats, F f)
+    {
+        double rv = 0;
+        for(int i = 0; i < repeats; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            sink += f();
+            auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            if(i == 0 || ns < rv)
+                rv = ns;
+        }
+        return rv;
+    }
+
+
+    static void report(const Input& input, const std::string& test, double bytes, double ns)
+    {
+        /* Alternations in patterns would otherwise split the cell. */
+        std::string cell;
+        for(char c : test)
+        {
+            if(c == '|')
+                cell += '\\';
+            cell += c;
+        }
+
+        /* Bytes per nanosecond and gigabytes per second are the same number. */
+        std::printf("| %-10s | %-50s | %12.0f | %8.4f | %7.3f |\n",
+                    input.name.c_str(), cell.c_str(), bytes, ns / bytes, bytes / ns);
+    }
+
+
+    /* Repeats text until it is at least size chars long. */
+    static Input synthesize(const std::string& name, const std::vector<wchar_t>& text, size_t size)
+    {
+        Input input;
+        input.name = name;
+        while(input.chars.size() < size)
+            input.chars.insert(input.chars.end(), text.begin(), text.end());
+        return input;
+    }
+
+
+    /* Splits code points into UTF-16 code units. */
+    static std::vector<wchar_t> utf16(const std::vector<unsigned>& codepoints)
+    {
+        std::vector<wchar_t> rv;
+        for(unsigned c : codepoints)
+        {
+            if(c < 0x10000)
+            {
+                rv.push_back(static_cast<wchar_t>(c));
+            }
+            else
+            {
+                rv.push_back(static_cast<wchar_t>(0xd800 + ((c - 0x10000) >> 10)));
+                rv.push_back(static_cast<wchar_t>(0xdc00 + ((c - 0x10000) & 0x3ff)));
+            }
+        }
+        return rv;
+    }
+
+
+    static std::vector<unsigned> ascii(const char* text)
+    {
+        std::vector<unsigned> rv;
+        for(; *text; ++text)
+            rv.push_back(static_cast<unsigned char>(*text));
+        return rv;
+    }
+
+
+    static bool load(const char* path, Input& input)
+    {
+        FILE* file = std::fopen(path, "rb");
+        if(!file)
+            return false;
+
+        input.name = "corpus";
+
+        /* Widened byte by byte, as Latin-1, which is how the Test program reads it. */
+        unsigned char block[65536];
+        size_t        read;
+        while((read = std::fread(block, 1, sizeof(block), file)) > 0)
+            input.chars.insert(input.chars.end(), block, block + read);
+
+        std::fclose(file);
+        return true;
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+    if(repeats < 1)
+        repeats = 1;
+
+    const size_t size = 16 << 20;
+
+    std::vector<Input> inputs;
+
+    if(argc > 1)
+    {
+        Input corpus;
+        if(!load(argv[1], corpus))
+        {
+            std::fprintf(stderr, "Cannot read %s\n", argv[1]);
+            return 1;
+        }
+        inputs.push_back(corpus);
+    }
+
+    inputs.push_back(synthesize("ascii", utf16(ascii("Tom Sawyer and Huckleberry Finn went down the river, ")), size));
+
+    std::vector<unsigned> latin1 = ascii("Tom Sawyer and the na");
+    latin1.push_back(0xef);
+    std::vector<unsigned> rest = ascii("ve fianc");
+    latin1.insert(latin1.end(), rest.begin(), rest.end());
+    latin1.push_back(0xe9);
+    rest = ascii("e went down the river, ");
+    latin1.insert(latin1.end(), rest.begin(), rest.end());
+    inputs.push_back(synthesize("latin1", utf16(latin1), size));
+
+    /* "Tom Sawyer went down the river" in Chinese: three bytes of UTF-8 for most chars. */
+    inputs.push_back(synthesize("cjk", utf16({ 0x6c64, 0x59c6, 0x00b7, 0x7d22, 0x4e9a, 0x987a, 0x6cb3, 0x800c, 0x4e0b, 0xff0c }), size));
+
+    /* Mathematical letters and emoji, with ASCII between them: pairs of surrogates in UTF-16. */
+    inputs.push_back(synthesize("astral", utf16({ 0x1d413, 0x1d428, 0x1d426, 0x20, 0x1f6f6, 0x20, 0x1d411, 0x1d422, 0x1d42f,
+                                                  0x1d41e, 0x1d42b, 0x20, 0x1f30a, 0x2c, 0x20 }), size));
+
+    const char* patterns[] = {
+        "Twain",
+        "Huck[a-zA-Z]+|Finn[a-zA-Z]+",
+        "a[^x]{20}b",
+        "Tom|Sawyer|Huckleberry|Finn",
+        "[a-zA-Z]+ing",
+        "([A-Za-z]awyer|[A-Za-z]inn)[^a-zA-Z]",
+        "Tom.{10,25}river|river.{10,25}Tom"
+    };
+
+    std::printf("| Input      | Test                                               |        Bytes |  ns/byte |    GB/s |\n");
+    std::printf("|------------|----------------------------------------------------|-------------:|---------:|--------:|\n");
+
+    for(Input& input : inputs)
+    {
+        const int      length = static_cast<int>(input.chars.size());
+        const wchar_t* chars  = input.chars.data();
+
+        std::vector<char> buffer(input.chars.size() * 3);
+        input.utf8.assign(buffer.data(), stringToUTF8(chars, length, buffer.data()));
+
+        const char* utf8  = input.utf8.data();
+        const int   bytes = static_cast<int>(input.utf8.size());
+
+        report(input, "stringToUTF8", 2.0 * length,
+               best(repeats, [&] { return stringToUTF8(chars, length, buffer.data()); }));
+
+        /* The result only says whether chars fit, so the loop runs in full either way. */
+        report(input, "stringToSingleByte (Latin-1)", 2.0 * length,
+               best(repeats, [&] { return stringToSingleByte(chars, length, buffer.data(), 0xff) + buffer[length - 1]; }));
+
+        report(input, "stringToSingleByte (ASCII)", 2.0 * length,
+               best(repeats, [&] { return stringToSingleByte(chars, length, buffer.data(), 0x7f) + buffer[length - 1]; }));
+
+        /* Run before the literal fast path of Regex.IsMatch, over the whole string. */
+        report(input, "hasLoneSurrogate", 2.0 * length,
+               best(repeats, [&] { return hasLoneSurrogate(chars, length); }));
+
+        report(input, "StrToCharPos", bytes,
+               best(repeats, [&] { return StrToCharPos(utf8, length); }));
+
+        report(input, "CharToStrPos", bytes,
+               best(repeats, [&] { return CharToStrPos(utf8, bytes); }));
+
+        for(const char* pattern : patterns)
+        {
+            RE2 re2(pattern);
+            if(!re2.ok())
+            {
+                std::fprintf(stderr, "Cannot compile %s: %s\n", pattern, re2.error().c_str());
+                return 1;
+            }
+
+            /* Every match, as Regex.Matches finds them, with group 0 only. */
+            report(input, std::string("RE2::Match ") + pattern, bytes, best(repeats, [&] {
+                re2::StringPiece text(utf8, bytes);
+                re2::StringPiece match;
+                long long        count = 0;
+                int              start = 0;
+                while(start <= bytes && re2.Match(text, start, bytes, RE2::UNANCHORED, &match, 1))
+                {
+                    int end = static_cast<int>(match.data() - utf8 + match.size());
+                    start   = match.empty() ? end + 1 : end;
+                    count++;
+                }
+                return count;
+            }));
+        }
+    }
+
+    return 0;
+}
@@ -1,7 +1,12 @@
 ﻿using System;
 using System.Collections.Generic;
 using System.Diagnostics;
+using System.Globalization;
+using System.Linq;
+using System.Runtime.Serialization;
+using System.Runtime.Serialization.Json;
 using System.Text;
+using System.Threading;
 using nn = System.Text.RegularExpressions;
 using rr = Re2.Net;
 
@@ -79,6 +84,137 @@ namespace Re2.Net.Test
             }
         }
 
+        [DataContract]
+        private class HarnessResult
+        {
+            [DataMember] public string Name;
+            [DataMember] public int    Iterations;
+            [DataMember] public double P50Milliseconds;
+            [DataMember] public double P90Milliseconds;
+            [DataMember] public double P99Milliseconds;
+            [DataMember] public double MegabytesPerSecond;
+            [DataMember] public double AllocatedBytesPerOperation;
+            [DataMember] public double Gen0PerOperation;
+            [DataMember] public double Gen1PerOperation;
+            [DataMember] public double Gen2PerOperation;
+        }
+
+        // Times an operation over warm-up and measured iterations, and compares the results with an earlier run.
+        private class Harness
+        {
+            public  List<HarnessResult> Results = new List<HarnessResult>();
+
+            private int warmup;
+            private int iterations;
+
+            public Harness(int warmup, int iterations)
+            {
+                this.warmup     = warmup;
+                this.iterations = Math.Max(iterations, 1);
+
+                // Counts the managed bytes allocated; native allocations in RE2 aren't seen. Can't be turned off again.
+                AppDomain.MonitoringIsEnabled = true;
+            }
+
+            // Nearest-rank percentile of sorted times.
+            public static double GetPercentile(List<double> sorted, double percentile)
+            {
+                return sorted[Math.Max((int)Math.Ceiling(percentile * sorted.Count) - 1, 0)];
+            }
+
+            public HarnessResult Run(string name, long bytes, Action operation)
+            {
+                for(int i = 0; i < warmup; i++)
+                    operation();
+
+                GC.Collect();
+                GC.WaitForPendingFinalizers();
+
+                var times     = new List<double>(iterations);
+                var watch     = new Stopwatch();
+                var allocated = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+                var gen0      = GC.CollectionCount(0);
+                var gen1      = GC.CollectionCount(1);
+                var gen2      = GC.CollectionCount(2);
+
+                for(int i = 0; i < iterations; i++)
+                {
+                    watch.Restart();
+                    operation();
+                    times.Add(TimerTicksToMilliseconds(watch.ElapsedTicks));
+                }
+
+                allocated = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize - allocated;
+                times.Sort();
+
+                var result = new HarnessResult {
+                    Name                       = name,
+                    Iterations                 = iterations,
+                    P50Milliseconds            = GetPercentile(times, 0.50),
+                    P90Milliseconds            = GetPercentile(times, 0.90),
+                    P99Milliseconds            = GetPercentile(times, 0.99),
+                    AllocatedBytesPerOperation = (double)allocated / iterations,
+                    Gen0PerOperation           = (double)(GC.CollectionCount(0) - gen0) / iterations,
+                    Gen1PerOperation           = (double)(GC.CollectionCount(1) - gen1) / iterations,
+                    Gen2PerOperation           = (double)(GC.CollectionCount(2) - gen2) / iterations
+                };
+                result.MegabytesPerSecond = bytes / 1048576d / (result.P50Milliseconds / 1000d);
+
+                Results.Add(result);
+                return result;
+            }
+
+            public void WriteJson(string path)
+            {
+                using(var stream = System.IO.File.Create(path))
+                    new DataContractJsonSerializer(typeof(List<HarnessResult>)).WriteObject(stream, Results);
+            }
+
+            public static List<HarnessResult> ReadJson(string path)
+            {
+                using(var stream = System.IO.File.OpenRead(path))
+                    return (List<HarnessResult>)new DataContractJsonSerializer(typeof(List<HarnessResult>)).ReadObject(stream);
+            }
+
+            public string ToTable()
+            {
+                var table = new StringBuilder("Benchmark|p50|p90|p99|MB/s|Allocated/op|Gen0/op|Gen2/op\n:---|---:|---:|---:|---:|---:|---:|---:");
+                foreach(var result in Results)
+                    table.Append(String.Format("\n{0}|{1} ms|{2} ms|{3} ms|{4}|{5} B|{6}|{7}", result.Name.Replace("|", "&#124;"),
+                                               result.P50Milliseconds.ToString(GetDoubleFormatString(result.P50Milliseconds)),
+                                               result.P90Milliseconds.ToString(GetDoubleFormatString(result.P90Milliseconds)),
+                                               result.P99Milliseconds.ToString(GetDoubleFormatString(result.P99Milliseconds)),
+                                               result.MegabytesPerSecond.ToString("0"), result.AllocatedBytesPerOperation.ToString("0"),
+                                               result.Gen0PerOperation.ToString("0.00"), result.Gen2PerOperation.ToString("0.00")));
+                return table.ToString();
+            }
+
+            // Compares p50 times by name. A benchmark slower than its baseline by more than threshold (0.1 for 10%) is
+            // flagged; benchmarks missing from either run are skipped.
+            public string Compare(List<HarnessResult> baseline, double threshold, out int regressions)
+            {
+                var table = new StringBuilder("Benchmark|Baseline p50|p50|Change|Status\n:---|---:|---:|---:|:---:");
+                regressions = 0;
+                foreach(var result in Results)
+                {
+                    var before = baseline.FirstOrDefault(b => b.Name == result.Name);
+                    if(before == null)
+                        continue;
+
+                    var change    = result.P50Milliseconds / before.P50Milliseconds - 1;
+                    var regressed = change > threshold;
+                    if(regressed)
+                        regressions++;
+
+                    table.Append(String.Format("\n{0}|{1} ms|{2} ms|{3}|{4}", result.Name.Replace("|", "&#124;"),
+                                               before.P50Milliseconds.ToString(GetDoubleFormatString(before.P50Milliseconds)),
+                                               result.P50Milliseconds.ToString(GetDoubleFormatString(result.P50Milliseconds)),
+                                               change.ToString("+0.0%;-0.0%"), regressed ? "**regression**" : "ok"));
+                }
+                return table.ToString();
+            }
+        }
+
         static void PrintByteVsStringResults(TestCase[] testcases)
         {
             var table = new StringBuilder("Regular Expression|Re2.Net|.NET Regex|Winner\n---|---:|---:|:---:");
@@ -119,6 +255,27 @@ namespace Re2.Net.Test
             Console.WriteLine(table.ToString());
         }
 
+        static void PrintBatchResults(string[] patterns, int[] threadCounts, double[,] medians)
+        {
+            var table = new StringBuilder("Regular Expression");
+            foreach(var threads in threadCounts)
+                table.Append(String.Format("|{0} thread{1}", threads, threads == 1 ? "" : "s"));
+            table.Append("|Scaling\n---");
+            foreach(var threads in threadCounts)
+                table.Append("|---:");
+            table.Append("|:---:");
+
+            for(int i = 0; i < patterns.Length; i++)
+            {
+                table.Append(String.Format("\n<code>{0}</code>", patterns[i].Replace("|", "&#124;").Replace("](", @"]\(")));
+                for(int j = 0; j < threadCounts.Length; j++)
+                    table.Append(String.Format("|{0} ms", medians[i, j].ToString(GetDoubleFormatString(medians[i, j]))));
+                /* Speedup of the widest run over a single thread. */
+                table.Append(String.Format("|**{0}x**", (medians[i, 0] / medians[i, threadCounts.Length - 1]).ToString("0.0")));
+            }
+            Console.WriteLine(table.ToString());
+        }
+
         static double TimerTicksToMilliseconds(long ticks)
         {
             return (double)ticks / (double)Stopwatch.Frequency * 1000d;
@@ -133,6 +290,13 @@ namespace Re2.Net.Test
                                 "0.0000";
         }
 
+        // The value following name on the command line, as in "--json results.json", or fallback if there isn't one.
+        static string GetArgument(string[] args, string name, string fallback)
+        {
+            var i = Array.IndexOf(args, name);
+            return i >= 0 && i + 1 < args.Length ? args[i + 1] : fallback;
+        }
+
         static void Main(string[] args)
         {
             try
@@ -207,6 +371,326 @@ namespace Re2.Net.Test
                     Console.WriteLine("\t... Success.\n");
                 }
 
+                {
+                    Console.WriteLine("Running batch tests ...");
+                    var records = new List<string> { "red car", "", "white car", "blue bike" };
+                    var r = new rr.Regex(@"(\w+)\s+car");
+                    var found = r.IsMatchBatch(records);
+                    Debug.Assert(found.Length == 4);
+                    Debug.Assert(found[0] && !found[1] && found[2] && !found[3]);
+                    var matches = r.MatchBatch(records, 1);
+                    Debug.Assert(matches[2].Groups[1].Value == "white");
+                    Debug.Assert(matches[3] == Match.Empty);
+                    var byteRecords = records.ConvertAll(record => Encoding.UTF8.GetBytes(record));
+                    Debug.Assert(r.IsMatchBatch(byteRecords)[2]);
+                    Debug.Assert(r.MatchBatch(byteRecords)[0].Index == 0);
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running replica tests ...");
+                    Debug.Assert(new rr.Regex("a", rr.RegexOptions.OneLine | rr.RegexOptions.POSIX).IsMatch("a"));
+                    var r = new rr.Regex(@"(\w+)\s+car", rr.RegexOptions.ThreadReplicas, 1 << 20);
+                    Debug.Assert(r.ReplicaCount == 1);
+                    var hits = 0;
+                    System.Threading.Tasks.Parallel.For(0, 10000, i => {
+                        if(r.Match(i % 2 == 0 ? "red car" : "blue bike").Groups[1].Value == "red")
+                            System.Threading.Interlocked.Increment(ref hits);
+                    });
+                    Debug.Assert(hits == 5000);
+                    Debug.Assert(r.ReplicaCount >= 1 && r.ReplicaCount <= Environment.ProcessorCount);
+                    Debug.Assert(r.MemoryBudget == (long)r.ReplicaCount << 20);
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running unmanaged input tests ...");
+                    var bytes = Encoding.UTF8.GetBytes("xx red car, white car xx");
+                    var r = new rr.Regex(@"(\w+) car");
+                    var segment = new ArraySegment<byte>(bytes, 3, 18);
+                    Debug.Assert(r.IsMatch(segment));
+                    Debug.Assert(r.Match(segment).Index == 0 && r.Match(segment).Groups[1].Value == "red");
+                    Debug.Assert(r.Matches(segment).Count == 2);
+                    Debug.Assert(!r.IsMatch(new ArraySegment<byte>(bytes, 0, 3)));
+                    var data = System.Runtime.InteropServices.Marshal.AllocHGlobal(bytes.Length);
+                    try
+                    {
+                        System.Runtime.InteropServices.Marshal.Copy(bytes, 0, data, bytes.Length);
+                        Debug.Assert(r.IsMatch(data, bytes.Length));
+                        Debug.Assert(!r.IsMatch(data, 3));
+                        var match = r.Match(data, bytes.Length);
+                        Debug.Assert(match.Index == 3 && match.Value == "red car");
+                        Debug.Assert(match.NextMatch().Groups[1].Value == "white");
+                        Debug.Assert(r.Matches(data, bytes.Length).Count == 2);
+                        Debug.Assert(!r.IsMatch(IntPtr.Zero, 0));
+                    }
+                    finally
+                    {
+                        System.Runtime.InteropServices.Marshal.FreeHGlobal(data);
+                    }
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running pinning tests ...");
+                    var bytes = Encoding.ASCII.GetBytes("one two three");
+                    var match = new rr.Regex(@"\w+").Match(bytes);
+                    // Nothing is pinned between calls, so the array is free to move here.
+                    GC.Collect();
+                    GC.WaitForPendingFinalizers();
+                    GC.Collect();
+                    Debug.Assert(match.Value == "one" && match.NextMatch().Value == "two");
+                    Debug.Assert(match.NextMatch().NextMatch().Index == 8);
+                    Debug.Assert(new rr.Regex("").Match(new byte[0]).Success);
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running anchored match tests ...");
+                    var r = new rr.Regex(@"\d{3}-\d{4}");
+                    Debug.Assert(r.FullMatch("555-1234") && !r.FullMatch("555-12345") && !r.FullMatch("x555-1234"));
+                    Debug.Assert(r.PrefixMatch("555-12345") && !r.PrefixMatch("x555-1234"));
+                    Debug.Assert(r.FullMatch("tel: 555-1234;", 5, 8) && !r.FullMatch("tel: 555-1234;", 5, 9));
+                    Debug.Assert(r.FullMatch(Encoding.ASCII.GetBytes("555-1234")));
+                    Debug.Assert(r.PrefixMatch(Encoding.ASCII.GetBytes("tel: 555-1234"), 5, 8));
+                    Debug.Assert(rr.Regex.FullMatch("水水-Ǆ", @"\pL+-Ǆ") && !rr.Regex.PrefixMatch("水水-Ǆ", "-Ǆ"));
+                    Debug.Assert(new rr.Regex(@"\d{3}-\d{4}").FullMatch("水Ǆ 555-1234", 3, 8));
+                    Debug.Assert(!new rr.Regex("水水").IsMatch("ab水水", 3) && new rr.Regex("水水").IsMatch("ab水水", 2));
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running cursor tests ...");
+                    var word   = new rr.Regex(@"(\pL+)");
+                    var space  = new rr.Regex(@"\s+");
+                    var cursor = new rr.RegexCursor("水Ǆ two  three");
+                    var first  = cursor.Consume(word);
+                    Debug.Assert(first.Value == "水Ǆ" && cursor.Position == 2);
+                    Debug.Assert(cursor.Consume(word) == Match.Empty && cursor.Position == 2);
+                    Debug.Assert(cursor.Consume(space).Length == 1 && cursor.Consume(word).Groups[1].Index == 3);
+                    var last = cursor.FindAndConsume(word);
+                    Debug.Assert(last.Value == "three" && last.Index == 8 && cursor.IsAtEnd);
+                    var bytecursor = new rr.RegexCursor(Encoding.ASCII.GetBytes("a=1;b=22"), rr.RegexOptions.ASCII);
+                    var pair = new rr.Regex(@"(\w)=(\d+);?", rr.RegexOptions.ASCII);
+                    Debug.Assert(bytecursor.Consume(pair).Groups[2].Value == "1" && bytecursor.Consume(pair).Groups[2].Index == 6);
+                    Debug.Assert(bytecursor.IsAtEnd && bytecursor.Position == 8);
+                    try { cursor.Consume(pair); Debug.Assert(false); } catch(ArgumentException) { }
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running typed extraction tests ...");
+                    var range  = new rr.Regex(@"(\w+)-(\w+)");
+                    var ints   = new int[2];
+                    Debug.Assert(range.TryExtract("ports 80-8080", ints) && ints[0] == 80 && ints[1] == 8080);
+                    Debug.Assert(range.TryExtract(Encoding.ASCII.GetBytes("ff-10"), ints, rr.NumberBase.Hex) && ints[0] == 255 && ints[1] == 16);
+                    Debug.Assert(range.TryExtract("0x1f-017", ints, rr.NumberBase.CRadix) && ints[0] == 31 && ints[1] == 15);
+                    Debug.Assert(!range.TryExtract("a-b", ints) && !range.TryExtract("no match", ints));
+                    var longs = new long[1];
+                    Debug.Assert(range.TryExtract("8589934592-x", longs) && longs[0] == 8589934592L);
+                    var doubles = new double[2];
+                    Debug.Assert(new rr.Regex(@"([\d.]+),([\d.]+)").TryExtract("at 1.5,2.25", doubles) && doubles[0] == 1.5 && doubles[1] == 2.25);
+                    Debug.Assert(range.TryExtract("x-y", new int[0]));
+                    try { range.TryExtract("1-2", new int[3]); Debug.Assert(false); } catch(ArgumentException) { }
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running sorted range tests ...");
+                    byte[] min, max;
+                    Debug.Assert(new rr.Regex("(?i)abc").PossibleMatchRange(10, out min, out max));
+                    Debug.Assert(Encoding.ASCII.GetString(min) == "ABC" && Encoding.ASCII.GetString(max) == "abc");
+                    try { new rr.Regex("abc").PossibleMatchRange(-1, out min, out max); Debug.Assert(false); } catch(ArgumentOutOfRangeException) { }
+                    var keys = new[] { "apple", "apricot", "banana", "band", "bandana", "can", "水" };
+                    Debug.Assert(new rr.Regex("ban.*").FullMatchSorted(keys).SequenceEqual(new[] { 2, 3, 4 }));
+                    Debug.Assert(new rr.Regex("band(ana)?").FullMatchSorted(keys).SequenceEqual(new[] { 3, 4 }));
+                    Debug.Assert(new rr.Regex(".*an.*").FullMatchSorted(keys).SequenceEqual(new[] { 2, 3, 4, 5 }));
+                    Debug.Assert(new rr.Regex("水|ap.*").FullMatchSorted(keys).SequenceEqual(new[] { 0, 1, 6 }));
+                    var bytekeys = keys.Take(6).Select(k => Encoding.ASCII.GetBytes(k)).ToList();
+                    Debug.Assert(new rr.Regex("ba.d", rr.RegexOptions.Latin1).FullMatchSorted(bytekeys).SequenceEqual(new[] { 3 }));
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running regex set tests ...");
+                    var set = new rr.RegexSet(new[] { @"error.*disk", @"(?i)timeout|refused", @"\d+", @"foo(bar|baz)qux", @"(?i)kelvin" });
+                    Debug.Assert(set.Count == 5 && set.UnfilteredCount == 1 && set[3].Pattern == "foo(bar|baz)qux");
+                    Debug.Assert(set.Match("disk error").SequenceEqual(new int[0]));
+                    Debug.Assert(set.Match("error on disk 7").SequenceEqual(new[] { 0, 2 }));
+                    Debug.Assert(set.Match("Connection REFUSED").SequenceEqual(new[] { 1 }));
+                    Debug.Assert(set.Match(Encoding.UTF8.GetBytes("foobazqux \u212Aelvin")).SequenceEqual(new[] { 3, 4 }));
+                    Debug.Assert(set.IsMatch("42") && !set.IsMatch("nothing here"));
+                    Debug.Assert(set.InputCount == 6 && set.CandidateCount < set.InputCount * set.Count && set.CandidateRate > 0);
+                    set.ResetCounters();
+                    Debug.Assert(set.InputCount == 0 && set.CandidateCount == 0 && set.MatchCount == 0);
+                    try { new rr.RegexSet(new[] { "a", null }); Debug.Assert(false); } catch(ArgumentNullException) { }
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running literal alternation tests ...");
+                    var names = new rr.Regex("Tom|Sawyer|Huckleberry|Finn");
+                    var story = "Huck Finn met Tom Sawyer";
+                    Debug.Assert(names.Match(story).Value == "Finn" && names.Match(story).Index == 5);
+                    Debug.Assert(names.Match(story, 6).Value == "Tom" && names.Matches(story).Count == 3);
+                    Debug.Assert(new rr.Regex("(Sa|Sawyer)").Match("Tom Sawyer").Groups[1].Value == "Sa");
+                    Debug.Assert(new rr.Regex(@"(?:水|火|\.)").Match("ab火水").Index == 2);
+                    Debug.Assert(names.IsMatch(Encoding.ASCII.GetBytes(new string('x', 100) + "Finn")) && !names.IsMatch(new string('x', 100) + "Fin"));
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running literal substring tests ...");
+                    var literal = new rr.Regex("a.b(水)", rr.RegexOptions.Literal);
+                    Debug.Assert(literal.IsMatch(new string('x', 40) + "a.b(水)") && !literal.IsMatch("axb(水)"));
+                    Debug.Assert(literal.Match("水水a.b(水)", 1).Index == 2 && literal.Match("水水a.b(水)").Length == 6);
+                    Debug.Assert(literal.Matches("a.b(水)a.b(水)").Count == 2 && literal.FullMatch("a.b(水)") && !literal.PrefixMatch("xa.b(水)"));
+                    var ignoreCase = new rr.Regex("Needle", rr.RegexOptions.Literal | rr.RegexOptions.IgnoreCase);
+                    Debug.Assert(ignoreCase.Match(new string('n', 33) + "nEEDLE").Index == 33 && ignoreCase.IsMatch(Encoding.ASCII.GetBytes("NEEDLE")));
+                    Debug.Assert(new rr.Regex("m", rr.RegexOptions.Literal | rr.RegexOptions.Multiline).Match("(?m)").Value == "m");
+                    Debug.Assert(new rr.Regex("", rr.RegexOptions.Literal).Matches("ab").Count == 3);
+                    // A lone surrogate swallows the char after it when converted; IsMatch and Match must still agree.
+                    var abc = new rr.Regex("abc", rr.RegexOptions.Literal);
+                    Debug.Assert(abc.IsMatch("\uD800abc") == (abc.Match("\uD800abc") != Match.Empty) && abc.IsMatch("\uD83D\uDE00abc"));
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running inner literal tests ...");
+                    var ing = new rr.Regex("[a-zA-Z]+ing");
+                    Debug.Assert(ing.Strategy == rr.MatchStrategy.InnerLiteral && new rr.Regex("ing[a-z]+").Strategy == rr.MatchStrategy.Automaton);
+                    Debug.Assert(new rr.Regex("Tom|Finn").Strategy == rr.MatchStrategy.LiteralAlternation && new rr.Regex("x", rr.RegexOptions.Literal).Strategy == rr.MatchStrategy.Substring);
+                    Debug.Assert(ing.Match("the king is singing").Value == "king" && ing.Matches("the king is singing").Count == 2 && !ing.IsMatch("ing ing"));
+                    var river = new rr.Regex("Tom.{10,25}river");
+                    Debug.Assert(river.Strategy == rr.MatchStrategy.InnerLiteral && river.IsMatch("Tom went down to the river") && !river.IsMatch("Tom, river"));
+                    Debug.Assert(new rr.Regex(@"\d+px").Match("width: 120px").Value == "120px" && new rr.Regex("é+ab").Match("xééab").Index == 1);
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running bit-parallel tests ...");
+                    var counted = new rr.Regex("a[^x]{20}b");
+                    var hay = "xa" + new string('y', 20) + "bz";
+                    Debug.Assert(counted.Strategy == rr.MatchStrategy.BitParallel && new rr.Regex("a[^x]*b").Strategy == rr.MatchStrategy.Automaton);
+                    Debug.Assert(counted.IsMatch(hay) && counted.Match(hay).Index == 1 && counted.Match(hay).Length == 22 && !counted.IsMatch("a" + new string('y', 19) + "b"));
+                    var line = new rr.Regex("^.{3,5}$", rr.RegexOptions.Multiline);
+                    Debug.Assert(line.Strategy == rr.MatchStrategy.BitParallel && line.Match("ab\nabcd\nx").Value == "abcd" && !line.IsMatch("ab\nabcdefg"));
+                    Debug.Assert(new rr.Regex("b.{2}", rr.RegexOptions.Latin1).Match(new byte[] { 0x62, 0xe9, 0x41 }).Length == 3);
+                    Debug.Assert(new rr.Regex("é.{2}b").Strategy == rr.MatchStrategy.Automaton && new rr.Regex("a.{2}b").Match("aééb").Value == "aééb");
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running compilation and warm-up tests ...");
+                    var compiled = rr.Regex.CompileAsync(@"(\w+)@(\w+)\.com", rr.RegexOptions.None, new[] { "mail bob@example.com today", "nothing" });
+                    Debug.Assert(compiled.Result.Match("x a@b.com").Groups[2].Value == "b");
+                    try { rr.Regex.CompileAsync("(").Wait(); Debug.Assert(false); } catch(AggregateException ex) { Debug.Assert(ex.InnerException is ArgumentException); }
+                    try { rr.Regex.CompileAsync(null); Debug.Assert(false); } catch(ArgumentNullException) { }
+                    var warm = new rr.Regex("a[^x]{20}b|Twain");
+                    warm.WarmUp(new[] { "Mark Twain", "" });
+                    warm.WarmUp(new List<byte[]> { new byte[0], Encoding.ASCII.GetBytes("Twain") });
+                    try { warm.WarmUp(new string[] { null }); Debug.Assert(false); } catch(ArgumentNullException) { }
+                    Debug.Assert(warm.Match("Mark Twain").Index == 5);
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running bulk compilation tests ...");
+                    string[] errors;
+                    var definitions = new[] { Tuple.Create(@"b(\d+)", rr.RegexOptions.None, 1 << 23), Tuple.Create("a(b", rr.RegexOptions.None, 1 << 23),
+                                              Tuple.Create("Twain", rr.RegexOptions.Latin1 | rr.RegexOptions.IgnoreCase, 1 << 20), Tuple.Create("é", rr.RegexOptions.ASCII, 1 << 23) };
+                    var regexes = rr.Regex.CompileAll(definitions, out errors, true);
+                    Debug.Assert(regexes.Length == 4 && errors.Length == 4);
+                    Debug.Assert(regexes[0].Match("ab12").Groups[1].Value == "12" && errors[0] == null);
+                    Debug.Assert(regexes[1] == null && errors[1].StartsWith("Missing parenthesis"));
+                    Debug.Assert(regexes[2].IsMatch("mark twain") && errors[2] == null);
+                    Debug.Assert(regexes[3] == null && errors[3] != null);
+                    Debug.Assert(rr.Regex.IsMatch("b7", @"b(\d+)"));
+                    Debug.Assert(rr.Regex.CompileAll(new Tuple<string, rr.RegexOptions, int>[0], out errors).Length == 0 && errors.Length == 0);
+                    try { rr.Regex.CompileAll(new Tuple<string, rr.RegexOptions, int>[] { null }, out errors); Debug.Assert(false); } catch(ArgumentNullException) { }
+                    try { rr.Regex.CompileAll(definitions, out errors, false, 0); Debug.Assert(false); } catch(ArgumentOutOfRangeException) { }
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running cache manifest tests ...");
+                    var manifest = System.IO.Path.GetTempFileName();
+                    rr.Regex.RecordCacheUsage = true;
+                    for(int i = 0; i < 3; i++)
+                        rr.Regex.IsMatch("a%0A\nb", "%0A\n");
+                    rr.Regex.IsMatch("Twain", "T.ain", rr.RegexOptions.Latin1);
+                    rr.Regex.RecordCacheUsage = false;
+                    rr.Regex.IsMatch("x", "x");
+                    rr.Regex.SaveCacheManifest(manifest);
+                    var lines = System.IO.File.ReadAllLines(manifest);
+                    Debug.Assert(lines.Length == 2 && lines[0] == "3\t00000000\t%250A%0A" && lines[1].StartsWith("1\t") && lines[1].EndsWith("\tT.ain"));
+                    rr.Regex.LoadCacheManifest(manifest).Wait();
+                    rr.Regex.SaveCacheManifest(manifest);
+                    Debug.Assert(System.IO.File.ReadAllLines(manifest)[0].StartsWith("6\t"));
+                    rr.Regex.LoadCacheManifest(manifest + ".missing").Wait();
+                    System.IO.File.WriteAllText(manifest, "not a manifest\n");
+                    try { rr.Regex.LoadCacheManifest(manifest); Debug.Assert(false); } catch(FormatException) { }
+                    try { rr.Regex.LoadCacheManifest(manifest, -1); Debug.Assert(false); } catch(ArgumentOutOfRangeException) { }
+                    System.IO.File.Delete(manifest);
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running introspection tests ...");
+                    var small = new rr.Regex(@"abc(\d+)-(\d+)x");
+                    var large = new rr.Regex(@"(\w+)(\d+)[a-z]{50}");
+                    Debug.Assert(small.ProgramSize > 0 && large.ProgramSize > small.ProgramSize);
+                    Debug.Assert(small.CapturingGroupCount == 2 && new rr.Regex("a(?:b)").CapturingGroupCount == 0);
+                    Debug.Assert(small.RequiredPrefix == "abc" && large.RequiredPrefix == "");
+                    Debug.Assert(new rr.Regex(@"éa\d").RequiredPrefix == "éa" && new rr.Regex("abc", rr.RegexOptions.IgnoreCase).RequiredPrefix == "");
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running explicit capture tests ...");
+                    var named = new rr.Regex(@"(\w+)\s(?P<verb>\w+)", rr.RegexOptions.ExplicitCapture);
+                    Debug.Assert(named.CapturingGroupCount == 1 && named.Pattern == @"(\w+)\s(?P<verb>\w+)");
+                    var namedMatch = named.Match("Tom went");
+                    Debug.Assert(namedMatch.Groups.Count == 2 && namedMatch.Groups["verb"].Value == "went" && namedMatch.Groups[1].Value == "went");
+                    // Escaped, quoted, and bracketed parentheses are left alone.
+                    var literal = new rr.Regex(@"[(]\((\d)\)\Q(x)\E", rr.RegexOptions.ExplicitCapture);
+                    Debug.Assert(literal.CapturingGroupCount == 0 && literal.Match("a((7)(x)").Value == "((7)(x)");
+                    Debug.Assert(new rr.Regex("(a)(b)", rr.RegexOptions.ExplicitCapture | rr.RegexOptions.POSIX).CapturingGroupCount == 2);
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running group selection tests ...");
+                    var dated = new rr.Regex(@"(\d{4})-(\d{2})-(\d{2})");
+                    var whole = dated.MatchGroups("on 2014-03-15 and 2015-04-16", 0);
+                    Debug.Assert(whole.Value == "2014-03-15" && whole.Groups.Count == 1);
+                    var year = dated.MatchGroups("on 2014-03-15", 1);
+                    Debug.Assert(year.Groups.Count == 2 && year.Groups[1].Value == "2014" && !year.Groups[2].Success);
+                    Debug.Assert(dated.MatchGroups("2014-03-15", 100).Groups.Count == 4);
+                    // The mask carries over to NextMatch(): only group 3 is captured, and groups 1 and 2 are left empty.
+                    var days = dated.MatchesGroups("on 2014-03-15 and 2015-04-16", 1L << 3);
+                    Debug.Assert(days.Count == 2 && days[1].Groups.Count == 4 && days[1].Groups[3].Value == "16" && !days[1].Groups[1].Success);
+                    Debug.Assert(dated.MatchesGroups(Encoding.ASCII.GetBytes("2014-03-15"), -1)[0].Groups[2].Value == "03");
+                    Console.WriteLine("\t... Success.\n");
+                }
+
+                {
+                    Console.WriteLine("Running telemetry tests ...");
+                    Debug.Assert(new rr.Regex("a").Telemetry == null);
+                    var counted   = new rr.Regex(@"(\w+)@(\w+)", rr.RegexOptions.Telemetry);
+                    var telemetry = counted.Telemetry;
+                    Debug.Assert(telemetry.Pattern == @"(\w+)@(\w+)" && telemetry.Calls == 0);
+                    Debug.Assert(counted.Matches("é " + new string('-', 100000) + " a@b c@d").Count == 2);
+                    Debug.Assert(!counted.IsMatch("nothing here"));
+                    Debug.Assert(telemetry.Calls == 4 && telemetry.Matches == 2 && telemetry.BytesScanned > 0);
+                    Debug.Assert(telemetry.SearchNanoseconds > 0 && telemetry.ConversionNanoseconds > 0);
+                    Debug.Assert(telemetry.PositionNanoseconds + telemetry.AllocationNanoseconds > 0);
+                    telemetry.Reset();
+                    Debug.Assert(telemetry.Calls == 0 && telemetry.SearchNanoseconds == 0);
+                    Debug.Assert(rr.RegexEventSource.Log.Name == "Re2-Net");
+                    Console.WriteLine("\t... Success.\n");
+                }
+
                 {
                     Console.WriteLine("Running performance tests ...\n");
 
@@ -363,6 +847,597 @@ namespace Re2.Net.Test
                     PrintStringVsStringResults(testcases);
 
                     Console.WriteLine("\n\t... Success.\n");
+
+                    Console.Write("\n\n\tRunning 'Batch' test...");
+
+                    // Every line of the corpus is a record, as in a log or CSV ingest.
+                    var lines     = haystring.Split('\n');
+                    var linebytes = new List<byte[]>(lines.Length);
+                    foreach(var line in lines)
+                        linebytes.Add(Encoding.ASCII.GetBytes(line));
+
+                    var threadCounts = new List<int>();
+                    for(int threads = 1; threads < Environment.ProcessorCount; threads *= 2)
+                        threadCounts.Add(threads);
+                    threadCounts.Add(Environment.ProcessorCount);
+
+                    var patterns     = Array.ConvertAll(testcases, testcase => testcase.Pattern);
+                    var byteMedians  = new double[patterns.Length, threadCounts.Count];
+                    var lineMedians  = new double[patterns.Length, threadCounts.Count];
+
+                    for(int i = 0; i < patterns.Length; i++)
+                    {
+                        var re2b = new rr.Regex(patterns[i], rr.RegexOptions.Latin1);
+                        var re2s = new rr.Regex(patterns[i]);
+
+                        Debug.Assert(re2s.IsMatchBatch(lines, 1)[lines.Length - 1] == re2s.IsMatch(lines[lines.Length - 1]));
+
+                        for(int j = 0; j < threadCounts.Count; j++)
+                        {
+                            var byteResults = new List<double>();
+                            var lineResults = new List<double>();
+
+                            for(int run = 0; run < 5; run++)
+                            {
+                                watch.Start();
+                                re2b.IsMatchBatch(linebytes, threadCounts[j]);
+                                byteResults.Add(TimerTicksToMilliseconds(watch.ElapsedTicks));
+                                watch.Reset();
+
+                                watch.Start();
+                                re2s.IsMatchBatch(lines, threadCounts[j]);
+                                lineResults.Add(TimerTicksToMilliseconds(watch.ElapsedTicks));
+                                watch.Reset();
+                            }
+
+                            byteResults.Sort();
+                            lineResults.Sort();
+                            byteMedians[i, j] = byteResults[byteResults.Count/2];
+                            lineMedians[i, j] = lineResults[lineResults.Count/2];
+                        }
+                    }
+
+                    Console.WriteLine("\n\nResults (" + lines.Length + " records):\n\n");
+
+                    PrintBatchResults(patterns, threadCounts.ToArray(), byteMedians);
+                    Console.WriteLine("\n");
+                    PrintBatchResults(patterns, threadCounts.ToArray(), lineMedians);
+
+                    Console.WriteLine("\n\t... Success.\n");
+
+                    Console.Write("\n\n\tRunning 'Tokenizer' test...");
+
+                    // Word-by-word scanning of a slice of the corpus: Match(input, startIndex) converts the whole slice per
+                    // token, RegexCursor converts it once.
+                    var tokenText   = haystring.Substring(0, 1 << 16);
+                    var tokenRegex  = new rr.Regex(@"\w+");
+                    var tokenCounts = new int[2];
+                    var tokenTimes  = new double[2];
+
+                    watch.Start();
+                    for(var m = tokenRegex.Match(tokenText, 0); m.Success; m = tokenRegex.Match(tokenText, m.Index + m.Length))
+                        tokenCounts[0]++;
+                    tokenTimes[0] = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                    watch.Reset();
+
+                    watch.Start();
+                    var tokenCursor = new rr.RegexCursor(tokenText);
+                    while(tokenCursor.FindAndConsume(tokenRegex).Success)
+                        tokenCounts[1]++;
+                    tokenTimes[1] = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                    watch.Reset();
+
+                    Debug.Assert(tokenCounts[0] == tokenCounts[1]);
+
+                    Console.WriteLine("\n\nResults:\n\n");
+                    Console.WriteLine(String.Format("Method|Tokens|Time\n:---|---:|---:\nRegex.Match(input, startIndex)|{0}|{1} ms\nRegexCursor.FindAndConsume|{2}|{3} ms",
+                                                    tokenCounts[0], tokenTimes[0].ToString(GetDoubleFormatString(tokenTimes[0])),
+                                                    tokenCounts[1], tokenTimes[1].ToString(GetDoubleFormatString(tokenTimes[1]))));
+
+                    Console.WriteLine("\n\t... Success.\n");
+
+                    Console.Write("\n\n\tRunning 'GC pressure' test...");
+
+                    // Many small Match() calls, as when scanning records one at a time. Gen0/Gen2 counts and the time
+                    // spent draining the finalizer queue afterwards show what each call leaves behind for the GC.
+                    var gcTable = new StringBuilder("Input|Outcome|Calls|Time|Gen0|Gen2|Finalizer drain\n:---|:---|---:|---:|---:|---:|---:");
+                    var gcCalls = 200000;
+                    var gcRegex = new rr.Regex(@"\bTom\b");
+                    foreach(var record in new[] { "Tom Swift and His Motor-Cycle", "Or, Fun and Adventures on the Road" })
+                    {
+                        var recordbytes = Encoding.ASCII.GetBytes(record);
+                        var outcome     = gcRegex.IsMatch(record) ? "match" : "no match";
+
+                        for(int pass = 0; pass < 2; pass++)
+                        {
+                            GC.Collect();
+                            GC.WaitForPendingFinalizers();
+                            var gen0 = GC.CollectionCount(0);
+                            var gen2 = GC.CollectionCount(2);
+
+                            watch.Start();
+                            for(int i = 0; i < gcCalls; i++)
+                                if(pass == 0)
+                                    gcRegex.Match(recordbytes);
+                                else
+                                    gcRegex.Match(record);
+                            var callTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                            watch.Reset();
+
+                            gen0 = GC.CollectionCount(0) - gen0;
+                            gen2 = GC.CollectionCount(2) - gen2;
+
+                            watch.Start();
+                            GC.Collect();
+                            GC.WaitForPendingFinalizers();
+                            var drainTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                            watch.Reset();
+
+                            gcTable.Append(String.Format("\n{0}|{1}|{2}|{3} ms|{4}|{5}|{6} ms", pass == 0 ? "byte[]" : "string", outcome, gcCalls,
+                                                         callTime.ToString(GetDoubleFormatString(callTime)), gen0, gen2,
+                                                         drainTime.ToString(GetDoubleFormatString(drainTime))));
+                        }
+                    }
+
+                    Console.WriteLine("\n\nResults:\n\n");
+                    Console.WriteLine(gcTable.ToString());
+
+                    Console.Write("\n\n\tRunning 'Sorted keys' test...");
+
+                    // A sorted key set of the kind a store scans by prefix. FullMatchSorted() only tests the keys between
+                    // the bounds of PossibleMatchRange(); the full scan tests every key.
+                    var sortedKeys = Enumerable.Range(0, 1000000).Select(i => String.Format("user:{0:D7}:session", i)).ToList();
+                    var sortedTable = new StringBuilder("Pattern|Full scan|Range scan|Matches\n:---|---:|---:|---:");
+                    foreach(var keyPattern in new[] { @"user:00042\d\d:.*", @"user:\d+:session", @".*:0000001:.*" })
+                    {
+                        var keyRegex = new rr.Regex(keyPattern);
+
+                        watch.Start();
+                        var scanned = sortedKeys.Count(k => keyRegex.FullMatch(k));
+                        var scanTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        watch.Start();
+                        var ranged = keyRegex.FullMatchSorted(sortedKeys).Length;
+                        var rangeTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        Debug.Assert(scanned == ranged);
+                        sortedTable.Append(String.Format("\n{0}|{1} ms|{2} ms|{3}", keyPattern.Replace("|", "&#124;"),
+                                                         scanTime.ToString(GetDoubleFormatString(scanTime)),
+                                                         rangeTime.ToString(GetDoubleFormatString(rangeTime)), ranged));
+                    }
+
+                    Console.WriteLine("\n\nResults:\n\n");
+                    Console.WriteLine(sortedTable.ToString());
+
+                    Console.Write("\n\n\tRunning 'Literal alternation' test...");
+
+                    // The same alternation with and without the literal fast path: "Fin[n]" keeps the pattern from being
+                    // recognized as plain literals, so RE2 searches for it on its own.
+                    var literalTable = new StringBuilder("Pattern|Input|Matches|Time\n:---|:---|---:|---:");
+                    foreach(var literalPattern in new[] { "Tom|Sawyer|Huckleberry|Finn", "Tom|Sawyer|Huckleberry|Fin[n]" })
+                    {
+                        var literalRegex = new rr.Regex(literalPattern, rr.RegexOptions.Latin1);
+                        for(int pass = 0; pass < 2; pass++)
+                        {
+                            watch.Start();
+                            var literalCount = pass == 0 ? literalRegex.Matches(haybytes).Count : literalRegex.Matches(haystring).Count;
+                            var literalTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                            watch.Reset();
+
+                            literalTable.Append(String.Format("\n{0}|{1}|{2}|{3} ms", literalPattern.Replace("|", "&#124;"), pass == 0 ? "byte[]" : "string",
+                                                              literalCount, literalTime.ToString(GetDoubleFormatString(literalTime))));
+                        }
+                    }
+
+                    Console.WriteLine("\n\nResults:\n\n");
+                    Console.WriteLine(literalTable.ToString());
+
+                    Console.Write("\n\n\tRunning 'Literal substring' test...");
+
+                    // The same text searched by RE2 and, with RegexOptions.Literal, without it. A string input is searched
+                    // without conversion in UTF-8 mode.
+                    var substringTable = new StringBuilder("Pattern|Options|Input|Matches|Time\n:---|:---|:---|---:|---:");
+                    foreach(var substringPattern in new[] { "Sherlock Holmes", "the ", "Zanzibar Express" })
+                    {
+                        foreach(var substringOptions in new[] { rr.RegexOptions.None, rr.RegexOptions.Literal, rr.RegexOptions.Literal | rr.RegexOptions.IgnoreCase })
+                        {
+                            var substringRegex = new rr.Regex(substringPattern, substringOptions);
+                            for(int pass = 0; pass < 2; pass++)
+                            {
+                                watch.Start();
+                                var substringCount = pass == 0 ? substringRegex.Matches(haybytes).Count : substringRegex.Matches(haystring).Count;
+                                var substringTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                                watch.Reset();
+
+                                substringTable.Append(String.Format("\n{0}|{1}|{2}|{3}|{4} ms", substringPattern, substringOptions, pass == 0 ? "byte[]" : "string",
+                                                                    substringCount, substringTime.ToString(GetDoubleFormatString(substringTime))));
+                            }
+                        }
+                    }
+
+                    Console.WriteLine("\n\nResults:\n\n");
+                    Console.WriteLine(substringTable.ToString());
+
+                    Console.Write("\n\n\tRunning 'Inner literal' test...");
+
+                    // Wrapping a pattern in a group keeps its inner literal from being found, so RE2 searches on its own.
+                    var innerTable = new StringBuilder("Pattern|Strategy|Matches|Time\n:---|:---|---:|---:");
+                    foreach(var innerPattern in new[] { "[a-zA-Z]+ing", "(?:[a-zA-Z]+ing)", "Tom.{10,25}river", "(?:Tom.{10,25}river)", @"\s[a-z]+ly\s", @"(?:\s[a-z]+ly\s)" })
+                    {
+                        var innerRegex = new rr.Regex(innerPattern, rr.RegexOptions.Latin1);
+
+                        watch.Start();
+                        var innerCount = innerRegex.Matches(haybytes).Count;
+                        var innerTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        innerTable.Append(String.Format("\n{0}|{1}|{2}|{3} ms", innerPattern, innerRegex.Strategy, innerCount,
+                                                        innerTime.ToString(GetDoubleFormatString(innerTime))));
+                    }
+
+                    Console.WriteLine("\n\nResults:\n\n");
+                    Console.WriteLine(innerTable.ToString());
+
+                    Console.Write("\n\n\tRunning 'Bit-parallel' test...");
+
+                    // As above, a group keeps the pattern from being recognized, so RE2's DFA searches on its own.
+                    var bitTable = new StringBuilder("Pattern|Strategy|IsMatch|Matches|Time\n:---|:---|---:|---:|---:");
+                    foreach(var bitPattern in new[] { "a[^x]{20}b", "(?:a[^x]{20}b)", "^.{16,20}$", "(?:^.{16,20}$)", "[0-9]{4}-[0-9]{2}", "(?:[0-9]{4}-[0-9]{2})" })
+                    {
+                        var bitRegex = new rr.Regex(bitPattern, rr.RegexOptions.Multiline | rr.RegexOptions.Latin1);
+
+                        watch.Start();
+                        var bitFound = bitRegex.IsMatch(haybytes);
+                        var bitCount = bitRegex.Matches(haybytes).Count;
+                        var bitTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        bitTable.Append(String.Format("\n{0}|{1}|{2}|{3}|{4} ms", bitPattern, bitRegex.Strategy, bitFound, bitCount,
+                                                      bitTime.ToString(GetDoubleFormatString(bitTime))));
+                    }
+
+                    Console.WriteLine("\n\nResults:\n\n");
+                    Console.WriteLine(bitTable.ToString());
+
+                    Console.Write("\n\n\tRunning 'Warm-up' test...");
+
+                    // The first search of a fresh Regex builds its DFA states as it goes; after WarmUp, they're cached.
+                    var warmSample = new List<byte[]> { haybytes.Take(1 << 16).ToArray() };
+                    var warmTable = new StringBuilder("Pattern|First search|First search after WarmUp\n:---|---:|---:");
+                    foreach(var warmPattern in new[] { "([A-Za-z]awyer|[A-Za-z]inn)[^a-zA-Z]", "(?:[a-q][^u-z]{13}x)", @"(?:""[^""]{0,30}[?!\.]"")" })
+                    {
+                        var coldRegex = new rr.Regex(warmPattern, rr.RegexOptions.Latin1);
+                        var warmRegex = new rr.Regex(warmPattern, rr.RegexOptions.Latin1);
+                        warmRegex.WarmUp(warmSample);
+
+                        watch.Start();
+                        coldRegex.IsMatch(haybytes);
+                        var coldTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        watch.Start();
+                        warmRegex.IsMatch(haybytes);
+                        var warmTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        warmTable.Append(String.Format("\n{0}|{1} ms|{2} ms", warmPattern.Replace("|", "&#124;"), coldTime.ToString(GetDoubleFormatString(coldTime)),
+                                                       warmTime.ToString(GetDoubleFormatString(warmTime))));
+                    }
+
+                    Console.WriteLine("\n\nResults:\n\n");
+                    Console.WriteLine(warmTable.ToString());
+
+                    Console.Write("\n\n\tRunning 'Bulk compilation' test...");
+
+                    // A rule set of the kind loaded at service startup, compiled one by one and then across all cores.
+                    var rules = Enumerable.Range(0, 5000).Select(i => Tuple.Create(String.Format(@"(?:user|host){0}[-_]\w{{2,8}}\s+(failed|denied|refused)\s+\d{{1,{1}}}", i, 3 + i % 20),
+                                                                                  rr.RegexOptions.None, 1 << 23)).ToList();
+                    var bulkTable = new StringBuilder("Rules|Sequential constructors|CompileAll\n:---|---:|---:");
+
+                    watch.Start();
+                    foreach(var rule in rules)
+                        new rr.Regex(rule.Item1, rule.Item2, rule.Item3);
+                    var sequentialTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                    watch.Reset();
+
+                    string[] bulkErrors;
+                    watch.Start();
+                    rr.Regex.CompileAll(rules, out bulkErrors);
+                    var bulkTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                    watch.Reset();
+
+                    Debug.Assert(bulkErrors.All(e => e == null));
+                    bulkTable.Append(String.Format("\n{0}|{1} ms|{2} ms", rules.Count, sequentialTime.ToString(GetDoubleFormatString(sequentialTime)),
+                                                   bulkTime.ToString(GetDoubleFormatString(bulkTime))));
+
+                    Console.WriteLine("\n\nResults:\n\n");
+                    Console.WriteLine(bulkTable.ToString());
+
+                    Console.Write("\n\n\tRunning 'Cache manifest' test...");
+
+                    // The first static call for each pattern compiles it, unless a manifest from an earlier run was loaded first.
+                    var cachedPatterns = rules.Take(200).Select(rule => rule.Item1).ToList();
+                    var cacheFile      = System.IO.Path.GetTempFileName();
+                    var cacheTable     = new StringBuilder("Patterns|First calls, cold cache|First calls after LoadCacheManifest\n:---|---:|---:");
+                    // Emptied, then given room for every pattern in the manifest.
+                    rr.Regex.CacheSize        = 0;
+                    rr.Regex.CacheSize        = 1000;
+                    rr.Regex.RecordCacheUsage = true;
+
+                    watch.Start();
+                    foreach(var cachedPattern in cachedPatterns)
+                        rr.Regex.IsMatch("host7_ab failed 12", cachedPattern);
+                    var coldCacheTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                    watch.Reset();
+
+                    rr.Regex.RecordCacheUsage = false;
+                    rr.Regex.SaveCacheManifest(cacheFile);
+                    rr.Regex.CacheSize = 0;
+                    rr.Regex.CacheSize = 1000;
+                    rr.Regex.LoadCacheManifest(cacheFile).Wait();
+
+                    watch.Start();
+                    foreach(var cachedPattern in cachedPatterns)
+                        rr.Regex.IsMatch("host7_ab failed 12", cachedPattern);
+                    var warmCacheTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                    watch.Reset();
+
+                    System.IO.File.Delete(cacheFile);
+                    cacheTable.Append(String.Format("\n{0}|{1} ms|{2} ms", cachedPatterns.Count, coldCacheTime.ToString(GetDoubleFormatString(coldCacheTime)),
+                                                    warmCacheTime.ToString(GetDoubleFormatString(warmCacheTime))));
+
+                    Console.WriteLine("\n\nResults:\n\n");
+                    Console.WriteLine(cacheTable.ToString());
+
+                    Console.Write("\n\n\tRunning 'Telemetry' test...");
+
+                    // The same Matches call with and without counters, to show what RegexOptions.Telemetry costs.
+                    var telemetryTable = new StringBuilder("Pattern|Without telemetry|With telemetry\n:---|---:|---:");
+                    foreach(var telemetryPattern in new[] { "Twain", "(Tom|Sawyer|Huckleberry|Finn)", @"(\w+)\s+river" })
+                    {
+                        var plainRegex   = new rr.Regex(telemetryPattern);
+                        var countedRegex = new rr.Regex(telemetryPattern, rr.RegexOptions.Telemetry);
+
+                        watch.Start();
+                        plainRegex.Matches(haystring).Count.ToString();
+                        var plainTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        watch.Start();
+                        countedRegex.Matches(haystring).Count.ToString();
+                        var countedTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        telemetryTable.Append(String.Format("\n{0}|{1} ms|{2} ms", telemetryPattern.Replace("|", "&#124;"), plainTime.ToString(GetDoubleFormatString(plainTime)),
+                                                            countedTime.ToString(GetDoubleFormatString(countedTime))));
+                    }
+
+                    Console.WriteLine("\n\nResults:\n\n");
+                    Console.WriteLine(telemetryTable.ToString());
+
+                    Console.Write("\n\n\tRunning 'Group selection' test...");
+
+                    // One Regex serving a call site that only needs the match and one that needs every group, against a Regex
+                    // created with RegexOptions.SingleCapture.
+                    var selectionTable = new StringBuilder("Pattern|Matches|MatchesGroups(input, 0)|SingleCapture\n:---|---:|---:|---:");
+                    foreach(var selectionPattern in new[] { "([A-Za-z]awyer|[A-Za-z]inn)[^a-zA-Z]", @"(\w+)\s+(river)", "(a)[^x]{20}(b)" })
+                    {
+                        var selectionRegex = new rr.Regex(selectionPattern, rr.RegexOptions.Latin1);
+                        var singleRegex    = new rr.Regex(selectionPattern, rr.RegexOptions.Latin1 | rr.RegexOptions.SingleCapture);
+                        var selectionTimes = new double[3];
+
+                        watch.Start();
+                        var selectionCount = selectionRegex.Matches(haybytes).Count;
+                        selectionTimes[0] = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        watch.Start();
+                        var maskedCount = selectionRegex.MatchesGroups(haybytes, 0).Count;
+                        selectionTimes[1] = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        watch.Start();
+                        var singleCount = singleRegex.Matches(haybytes).Count;
+                        selectionTimes[2] = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        Debug.Assert(maskedCount == selectionCount && singleCount == selectionCount);
+
+                        selectionTable.Append(String.Format("\n{0}|{1} ms|{2} ms|{3} ms", selectionPattern.Replace("|", "&#124;"),
+                                                            selectionTimes[0].ToString(GetDoubleFormatString(selectionTimes[0])),
+                                                            selectionTimes[1].ToString(GetDoubleFormatString(selectionTimes[1])),
+                                                            selectionTimes[2].ToString(GetDoubleFormatString(selectionTimes[2]))));
+                    }
+
+                    Console.WriteLine("\n\nResults:\n\n");
+                    Console.WriteLine(selectionTable.ToString());
+
+                    Console.Write("\n\n\tRunning 'Thread scaling' test...");
+
+                    // One Regex shared by every thread, the same with RegexOptions.ThreadReplicas, one Regex per thread, and the
+                    // static IsMatch, which shares the Regex in the cache. Every thread matches the same records, after one pass to
+                    // warm up, so perfect scaling is N times the single-thread throughput; efficiency is the fraction of that
+                    // reached. Latencies are per call, across all threads.
+                    var scalingRecords = lines.Take(20000).ToArray();
+                    var scalingBytes   = scalingRecords.Sum(record => (long)record.Length);
+                    var scalingConfigs = new[] { "Shared", "Shared, ThreadReplicas", "Per thread", "Static (cache)" };
+                    var scalingTable   = new StringBuilder("Regular Expression|Configuration|Threads|Throughput|Efficiency|p50|p99|p99.9\n---|:---|---:|---:|---:|---:|---:|---:");
+                    foreach(var scalingPattern in new[] { "Twain", "[a-zA-Z]+ing", "Tom.{10,25}river|river.{10,25}Tom" })
+                    {
+                        foreach(var scalingConfig in scalingConfigs)
+                        {
+                            rr.Regex shared           = null;
+                            double   singleThroughput = 0;
+
+                            if(scalingConfig == scalingConfigs[0])
+                                shared = new rr.Regex(scalingPattern);
+                            else if(scalingConfig == scalingConfigs[1])
+                                shared = new rr.Regex(scalingPattern, rr.RegexOptions.ThreadReplicas);
+
+                            foreach(var threads in threadCounts)
+                            {
+                                var latencies = new long[threads][];
+                                var ready     = new Barrier(threads + 1);
+                                var workers   = new Thread[threads];
+
+                                for(int t = 0; t < threads; t++)
+                                {
+                                    var worker = t;
+                                    workers[t] = new Thread(() => {
+                                        var regex   = scalingConfig == scalingConfigs[2] ? new rr.Regex(scalingPattern) : shared;
+                                        var elapsed = new long[scalingRecords.Length];
+                                        for(int pass = 0; pass < 2; pass++)
+                                        {
+                                            if(pass == 1)
+                                                ready.SignalAndWait();
+                                            for(int i = 0; i < scalingRecords.Length; i++)
+                                            {
+                                                var start = Stopwatch.GetTimestamp();
+                                                if(scalingConfig == scalingConfigs[3])
+                                                    rr.Regex.IsMatch(scalingRecords[i], scalingPattern);
+                                                else
+                                                    regex.IsMatch(scalingRecords[i]);
+                                                elapsed[i] = Stopwatch.GetTimestamp() - start;
+                                            }
+                                        }
+                                        latencies[worker] = elapsed;
+                                    });
+                                    workers[t].Start();
+                                }
+
+                                ready.SignalAndWait();
+                                watch.Start();
+                                foreach(var worker in workers)
+                                    worker.Join();
+                                var wallTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                                watch.Reset();
+
+                                var throughput = threads * scalingBytes / 1048576d / (wallTime / 1000d);
+                                if(threads == 1)
+                                    singleThroughput = throughput;
+
+                                var sorted = latencies.SelectMany(elapsed => elapsed).Select(ticks => ticks * 1000000d / Stopwatch.Frequency).OrderBy(us => us).ToList();
+                                Func<double, string> percentile = p => Harness.GetPercentile(sorted, p).ToString("0.0") + " µs";
+
+                                scalingTable.Append(String.Format("\n<code>{0}</code>|{1}|{2}|{3} MB/s|{4}|{5}|{6}|{7}", scalingPattern.Replace("|", "&#124;"), scalingConfig,
+                                                                  threads, throughput.ToString("0"), (throughput / (threads * singleThroughput)).ToString("0%"),
+                                                                  percentile(0.5), percentile(0.99), percentile(0.999)));
+                            }
+                        }
+                    }
+
+                    Console.WriteLine("\n\nResults (" + scalingRecords.Length + " records per thread):\n\n");
+                    Console.WriteLine(scalingTable.ToString());
+
+                    Console.Write("\n\n\tRunning 'Harness' test...");
+
+                    // IsMatch, Match, and Matches over string and byte inputs, with percentiles, throughput, and GC activity per
+                    // call. --warmup and --iterations set the number of runs, --json writes the results to a file, and --baseline
+                    // compares them with an earlier --json file, flagging any p50 slower by more than --threshold percent.
+                    // Throughput is over the whole input, even for calls that stop at the first match.
+                    var harness = new Harness(int.Parse(GetArgument(args, "--warmup", "2")), int.Parse(GetArgument(args, "--iterations", "10")));
+                    foreach(var harnessPattern in new[] { "Twain", "Huck[a-zA-Z]+|Finn[a-zA-Z]+", "[a-zA-Z]+ing", "Tom.{10,25}river|river.{10,25}Tom" })
+                    {
+                        var re2b = new rr.Regex(harnessPattern, rr.RegexOptions.Multiline | rr.RegexOptions.Latin1);
+                        var re2s = new rr.Regex(harnessPattern, rr.RegexOptions.Multiline);
+
+                        harness.Run("IsMatch(byte[]) " + harnessPattern, haybytes.Length, () => re2b.IsMatch(haybytes));
+                        harness.Run("IsMatch(string) " + harnessPattern, haybytes.Length, () => re2s.IsMatch(haystring));
+                        harness.Run("Match(byte[]) "   + harnessPattern, haybytes.Length, () => re2b.Match(haybytes));
+                        harness.Run("Match(string) "   + harnessPattern, haybytes.Length, () => re2s.Match(haystring));
+                        // Matches() methods are lazily evaluated.
+                        harness.Run("Matches(byte[]) " + harnessPattern, haybytes.Length, () => { var count = re2b.Matches(haybytes).Count; });
+                        harness.Run("Matches(string) " + harnessPattern, haybytes.Length, () => { var count = re2s.Matches(haystring).Count; });
+                    }
+
+                    Console.WriteLine("\n\nResults:\n\n");
+                    Console.WriteLine(harness.ToTable());
+
+                    Console.Write("\n\n\tRunning 'Encoding stress' test...");
+
+                    // The Twain text is ASCII, which is the cheapest case for converting strings and translating positions. These
+                    // generated corpora mix its words with Latin-1, CJK (three bytes of UTF-8), astral (surrogate pairs), and raw
+                    // binary runs, so that every pattern finds some matches. Byte arrays are UTF-8, except for the binary corpus,
+                    // which isn't valid UTF-8 and is searched as Latin-1. Results are added to the harness above.
+                    var stressWords   = haystring.Substring(0, 1 << 20).Split(new[] { ' ', '\r', '\n' }, StringSplitOptions.RemoveEmptyEntries);
+                    var stressRandom  = new Random(47);
+                    var stressCorpora = new List<Tuple<string, string, byte[], rr.RegexOptions>>();
+
+                    Func<double, Func<int, string>, string> generateCorpus = (wordRate, generateRun) => {
+                        var corpus = new StringBuilder(1 << 20);
+                        for(int i = 0; corpus.Length < 1 << 20; i++)
+                        {
+                            corpus.Append(stressRandom.NextDouble() < wordRate ? stressWords[i % stressWords.Length] : generateRun(1 + stressRandom.Next(8)));
+                            corpus.Append(i % 12 == 11 ? '\n' : ' ');
+                        }
+                        return corpus.ToString();
+                    };
+
+                    var latin1Accents = "àáâäçèéêëìíîïñòóôöùúûüÿ";
+                    var asciiCorpus   = haystring.Substring(0, 1 << 20);
+                    var latin1Corpus  = new String(asciiCorpus.Select(c => "aeiou".IndexOf(c) >= 0 && stressRandom.Next(2) == 0
+                                                                               ? latin1Accents[stressRandom.Next(latin1Accents.Length)] : c).ToArray());
+                    var cjkCorpus     = generateCorpus(0.2, n => new String(Enumerable.Range(0, n).Select(_ => (char)stressRandom.Next(0x4e00, 0xa000)).ToArray()));
+                    var astralCorpus  = generateCorpus(0.5, n => String.Concat(Enumerable.Range(0, n).Select(_ => Char.ConvertFromUtf32(stressRandom.Next(0x1f300, 0x1f650)))));
+                    var binaryCorpus  = generateCorpus(0.3, n => new String(Enumerable.Range(0, n * 4).Select(_ => (char)stressRandom.Next(0x100)).ToArray()));
+
+                    stressCorpora.Add(Tuple.Create("ascii",  asciiCorpus,  Encoding.UTF8.GetBytes(asciiCorpus),  rr.RegexOptions.None));
+                    stressCorpora.Add(Tuple.Create("latin1", latin1Corpus, Encoding.UTF8.GetBytes(latin1Corpus), rr.RegexOptions.None));
+                    stressCorpora.Add(Tuple.Create("cjk",    cjkCorpus,    Encoding.UTF8.GetBytes(cjkCorpus),    rr.RegexOptions.None));
+                    stressCorpora.Add(Tuple.Create("astral", astralCorpus, Encoding.UTF8.GetBytes(astralCorpus), rr.RegexOptions.None));
+                    // Every char is below 0x100, so this is the same bytes, one per char.
+                    stressCorpora.Add(Tuple.Create("binary", binaryCorpus, binaryCorpus.Select(c => (byte)c).ToArray(), rr.RegexOptions.Latin1));
+
+                    var stressTable = new StringBuilder("Regular Expression");
+                    foreach(var corpus in stressCorpora)
+                        stressTable.Append(String.Format("|{0} string|{0} byte[]", corpus.Item1));
+                    stressTable.Append("\n---");
+                    foreach(var corpus in stressCorpora)
+                        stressTable.Append("|---:|---:");
+
+                    foreach(var testcase in testcases)
+                    {
+                        stressTable.Append(String.Format("\n<code>{0}</code>", testcase.Pattern.Replace("|", "&#124;").Replace("](", @"]\(")));
+                        var re2s = new rr.Regex(testcase.Pattern, rr.RegexOptions.Multiline);
+                        foreach(var corpus in stressCorpora)
+                        {
+                            var re2b = new rr.Regex(testcase.Pattern, rr.RegexOptions.Multiline | corpus.Item4);
+
+                            // Matches() methods are lazily evaluated.
+                            var stringResult = harness.Run("Matches(string) [" + corpus.Item1 + "] " + testcase.Pattern, corpus.Item2.Length * 2,
+                                                           () => { var count = re2s.Matches(corpus.Item2).Count; });
+                            var byteResult   = harness.Run("Matches(byte[]) [" + corpus.Item1 + "] " + testcase.Pattern, corpus.Item3.Length,
+                                                           () => { var count = re2b.Matches(corpus.Item3).Count; });
+
+                            Debug.Assert(corpus.Item1 == "binary" || re2s.Matches(corpus.Item2).Count == re2b.Matches(corpus.Item3).Count);
+                            stressTable.Append(String.Format("|{0} MB/s|{1} MB/s", stringResult.MegabytesPerSecond.ToString("0"), byteResult.MegabytesPerSecond.ToString("0")));
+                        }
+                    }
+
+                    Console.WriteLine("\n\nResults (" + (1 << 20) + " chars per corpus; strings are counted at two bytes per char):\n\n");
+                    Console.WriteLine(stressTable.ToString());
+
+                    var jsonPath = GetArgument(args, "--json", null);
+                    if(jsonPath != null)
+                        harness.WriteJson(jsonPath);
+
+                    var baselinePath = GetArgument(args, "--baseline", null);
+                    if(baselinePath != null)
+                    {
+                        int regressions;
+                        var threshold = double.Parse(GetArgument(args, "--threshold", "10"), CultureInfo.InvariantCulture) / 100;
+
+                        Console.WriteLine("\n\nCompared with " + baselinePath + ":\n\n");
+                        Console.WriteLine(harness.Compare(Harness.ReadJson(baselinePath), threshold, out regressions));
+
+                        // Lets a build script fail on regressions.
+                        if(regressions > 0)
+                            Environment.ExitCode = 1;
+                    }
+
+                    Console.WriteLine("\n\t... Success.\n");
                 }
             }
             catch(Exception ex)
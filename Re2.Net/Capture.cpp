@@ -41,9 +41,14 @@ namespace Net
         if(_input->Bytes)
         {
             if(_input->IsUTF8)
-                return _utf8Encoding->GetString(_input->Bytes, _index, _length);
+                return _utf8Encoding->GetString(_input->Bytes, _input->Offset + _index, _length);
             else
-                return _latin1Encoding->GetString(_input->Bytes, _index, _length);
+                return _latin1Encoding->GetString(_input->Bytes, _input->Offset + _index, _length);
+        }
+        else if(_input->IsBorrowed)
+        {
+            /* Decoded straight from the caller's memory, which has to still be valid. */
+            return gcnew String((signed char*)_input->Data, _index, _length, _input->IsUTF8 ? _utf8Encoding : _latin1Encoding);
         }
         else
             return _input->Input->Substring(_index, _length);
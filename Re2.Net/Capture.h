@@ -69,7 +69,7 @@ namespace Net
             ///     The length of the captured subexpression.
             /// </value>
             /// <remarks>
-            ///     <c>Length</c> is given in characters, if the input is a string, or bytes, if the input is a byte array.
+            ///     <c>Length</c> is given in characters, if the input is a string, or bytes, if the input is a byte array or unmanaged memory.
             /// </remarks>
             property int Length { int get(); }
 
@@ -0,0 +1,483 @@
+/*
+ *  Re2.Net Copyright  2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#pragma managed(push, off)
+    #include <string.h>
+    #include <intrin.h>
+    #include <tmmintrin.h>
+    #include <string>
+    #include <vector>
+#pragma managed(pop)
+
+
+namespace Re2
+{
+namespace Net
+{
+    #pragma managed(push, off)
+
+    /* Checked once, with CPUID. SSE2 is only optional on Win32. */
+    static inline bool HasSSE2()
+    {
+        static const bool sse2 = [] {
+            int info[4];
+            __cpuid(info, 1);
+            return (info[3] & (1 << 26)) != 0;
+        }();
+        return sse2;
+    }
+
+
+    static inline bool HasSSSE3()
+    {
+        static const bool ssse3 = [] {
+            int info[4];
+            __cpuid(info, 1);
+            return (info[2] & (1 << 9)) != 0;
+        }();
+        return ssse3;
+    }
+
+
+    /*
+     *  Finds the leftmost occurrence of any of a small set of literal strings, so that a Regex whose
+     *  pattern is nothing more than such a set (e.g. "Tom|Sawyer|Huckleberry|Finn") needs RE2 only to
+     *  fill in captures.
+     *
+     *  With SSSE3, up to 16 positions are tested at once in the manner of Hyperscan's Teddy: each literal
+     *  gets a bit in a bucket mask, and the low and high nibbles of the first (up to) three bytes at each
+     *  position are looked up with PSHUFB in per-byte tables of the buckets whose literals could have that
+     *  nibble there. A position whose masks AND to a nonzero value is a candidate, which memcmp() confirms.
+     *  Without SSSE3, a table of first bytes does the same job one position at a time.
+     */
+    class LiteralSearch
+    {
+        public:
+
+            /* One bucket per literal. */
+            static const size_t MAX_LITERALS = 8;
+
+
+        private:
+
+            /*
+             *  _fingerprint : The number of leading bytes compared by the vector loop: 3, or the length of the
+             *                 shortest literal if less.
+             *
+             *  _lo, _hi     : For each fingerprint byte and nibble value, the buckets whose literal has that
+             *                 nibble in that byte. Kept unaligned, as a Win32 new only aligns to 8 bytes.
+             *
+             *  _first       : The buckets whose literal starts with each byte value.
+             */
+            std::vector<std::string> _literals;
+            int                      _fingerprint;
+            unsigned char            _lo[3][16];
+            unsigned char            _hi[3][16];
+            unsigned char            _first[256];
+
+
+            /* Returns true if any literal in buckets occurs at data[pos]. */
+            bool Confirm(const char* data, int size, int pos, unsigned buckets) const
+            {
+                for(size_t b = 0; buckets; ++b, buckets >>= 1)
+                {
+                    const std::string& literal = _literals[b];
+                    if((buckets & 1) && static_cast<size_t>(size - pos) >= literal.size() && !memcmp(data + pos, literal.data(), literal.size()))
+                        return true;
+                }
+                return false;
+            }
+
+
+            int FindScalar(const char* data, int size, int pos) const
+            {
+                for(; pos < size; ++pos)
+                {
+                    unsigned buckets = _first[static_cast<unsigned char>(data[pos])];
+                    if(buckets && Confirm(data, size, pos, buckets))
+                        return pos;
+                }
+                return -1;
+            }
+
+
+            int FindVector(const char* data, int size) const
+            {
+                const __m128i nibble = _mm_set1_epi8(0x0f);
+                const __m128i zero   = _mm_setzero_si128();
+                __m128i       lo[3];
+                __m128i       hi[3];
+
+                for(int j = 0; j < _fingerprint; ++j)
+                {
+                    lo[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_lo[j]));
+                    hi[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_hi[j]));
+                }
+
+                int pos = 0;
+                for(; pos + 16 + _fingerprint - 1 <= size; pos += 16)
+                {
+                    __m128i candidates = _mm_set1_epi8(-1);
+                    for(int j = 0; j < _fingerprint; ++j)
+                    {
+                        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + j));
+                        __m128i low   = _mm_shuffle_epi8(lo[j], _mm_and_si128(bytes, nibble));
+                        __m128i high  = _mm_shuffle_epi8(hi[j], _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble));
+                        candidates    = _mm_and_si128(candidates, _mm_and_si128(low, high));
+                    }
+
+                    unsigned lanes = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(candidates, zero))) & 0xffff;
+                    if(!lanes)
+                        continue;
+
+                    unsigned char buckets[16];
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(buckets), candidates);
+
+                    /* Lanes are tried in order, so the first confirmed is the leftmost. */
+                    while(lanes)
+                    {
+                        unsigned long lane;
+                        _BitScanForward(&lane, lanes);
+                        lanes &= lanes - 1;
+
+                        if(Confirm(data, size, pos + lane, buckets[lane]))
+                            return pos + lane;
+                    }
+                }
+
+                return FindScalar(data, size, pos);
+            }
+
+
+        public:
+
+            /* literals must hold between 2 and MAX_LITERALS non-empty strings. */
+            LiteralSearch(const std::vector<std::string>& literals)
+                : _literals(literals), _fingerprint(3)
+            {
+                memset(_lo, 0, sizeof(_lo));
+                memset(_hi, 0, sizeof(_hi));
+                memset(_first, 0, sizeof(_first));
+
+                for(size_t b = 0; b < _literals.size(); ++b)
+                    if(_literals[b].size() < static_cast<size_t>(_fingerprint))
+                        _fingerprint = static_cast<int>(_literals[b].size());
+
+                for(size_t b = 0; b < _literals.size(); ++b)
+                {
+                    unsigned char bit = static_cast<unsigned char>(1 << b);
+                    _first[static_cast<unsigned char>(_literals[b][0])] |= bit;
+
+                    for(int j = 0; j < _fingerprint; ++j)
+                    {
+                        unsigned char c = static_cast<unsigned char>(_literals[b][j]);
+                        _lo[j][c & 0x0f] |= bit;
+                        _hi[j][c >> 4]   |= bit;
+                    }
+                }
+            }
+
+
+            /* Returns the offset in data of the leftmost occurrence of any literal, or -1. */
+            int Find(const char* data, int size) const
+            {
+                return HasSSSE3() ? FindVector(data, size) : FindScalar(data, size, 0);
+            }
+    };
+
+
+    /*
+     *  Finds a single literal, for RegexOptions::Literal, in either the encoded input or a .NET string's
+     *  UTF-16 chars, optionally ignoring ASCII case.
+     *
+     *  The vector loop tests the two units of the literal that are least likely to occur in text, by a
+     *  rough ranking of English text and source code, against 16 bytes (or 8 chars) at a time. Testing
+     *  rare units rather than the first two cuts the number of false candidates passed on to the full
+     *  comparison, which is what makes "   the" as fast to find as "xyz".
+     */
+    class SubstringSearch
+    {
+        private:
+
+            /*
+             *  _rare   : The offsets, in the literal, of its rarest unit and second rarest (the same offset if
+             *            the literal has a single unit).
+             *
+             *  _chars  : The literal as UTF-16, if strings can be searched without conversion, i.e. in UTF-8
+             *            mode. Empty otherwise, with _hasChars false.
+             *
+             *  Both forms are kept with ASCII letters folded to lower case if _ignoreCase is set.
+             */
+            std::string  _bytes;
+            std::wstring _chars;
+            bool         _hasChars;
+            bool         _ignoreCase;
+            size_t       _rareBytes[2];
+            size_t       _rareChars[2];
+
+
+            template <typename T>
+            static unsigned Fold(T c)
+            {
+                return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : static_cast<unsigned>(c);
+            }
+
+
+            /* Higher is more common. Anything outside ASCII is treated as rare. */
+            static int Rank(unsigned c)
+            {
+                static const char common[] = " etaoinsrhldcumfpgwybvkxjqz";
+                if(c >= 'A' && c <= 'Z')
+                    c += 'a' - 'A';
+                const char* p = c && c < 0x80 ? strchr(common, static_cast<int>(c)) : nullptr;
+                if(p)
+                    return 200 - static_cast<int>(p - common);
+                if(c >= '0' && c <= '9')
+                    return 150;
+                if(c == ',' || c == '.' || c == '\n' || c == '\r' || c == '\t' || c == '-' || c == '_' || c == '(' || c == ')')
+                    return 140;
+                return c < 0x80 ? 100 : 50;
+            }
+
+
+            template <typename T>
+            static void ChooseRare(const T* literal, size_t length, size_t rare[2])
+            {
+                rare[0] = rare[1] = 0;
+                for(size_t i = 1; i < length; ++i)
+                    if(Rank(literal[i]) < Rank(literal[rare[0]]))
+                        rare[0] = i;
+
+                rare[1] = rare[0];
+                for(size_t i = 0; i < length; ++i)
+                    if(i != rare[0] && (rare[1] == rare[0] || Rank(literal[i]) < Rank(literal[rare[1]])))
+                        rare[1] = i;
+            }
+
+
+            template <typename T>
+            bool Equals(const T* data, const T* literal, size_t length) const
+            {
+                if(!_ignoreCase)
+                    return !memcmp(data, literal, length * sizeof(T));
+
+                for(size_t i = 0; i < length; ++i)
+                    if(Fold(data[i]) != static_cast<unsigned>(literal[i]))
+                        return false;
+                return true;
+            }
+
+
+            template <typename T>
+            int FindScalar(const T* data, int size, int pos, const T* literal, size_t length) const
+            {
+                int last = size - static_cast<int>(length);
+                for(; pos <= last; ++pos)
+                    if(Equals(data + pos, literal, length))
+                        return pos;
+                return -1;
+            }
+
+
+            /* Broadcasts a unit, and its upper case form if it is a folded letter. */
+            static void Broadcast(const unsigned char*, unsigned c, bool ignoreCase, __m128i& lower, __m128i& upper)
+            {
+                lower = _mm_set1_epi8(static_cast<char>(c));
+                upper = ignoreCase && c >= 'a' && c <= 'z' ? _mm_set1_epi8(static_cast<char>(c - ('a' - 'A'))) : lower;
+            }
+
+
+            static void Broadcast(const wchar_t*, unsigned c, bool ignoreCase, __m128i& lower, __m128i& upper)
+            {
+                lower = _mm_set1_epi16(static_cast<short>(c));
+                upper = ignoreCase && c >= 'a' && c <= 'z' ? _mm_set1_epi16(static_cast<short>(c - ('a' - 'A'))) : lower;
+            }
+
+
+            static __m128i Equal(const unsigned char*, __m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+            static __m128i Equal(const wchar_t*, __m128i a, __m128i b)       { return _mm_cmpeq_epi16(a, b); }
+
+            /* One bit per unit. Only every second bit is kept for chars, which fill two bytes each. */
+            static unsigned Units(const unsigned char*, __m128i m) { return static_cast<unsigned>(_mm_movemask_epi8(m)); }
+            static unsigned Units(const wchar_t*, __m128i m)       { return static_cast<unsigned>(_mm_movemask_epi8(m)) & 0x5555; }
+
+
+            template <typename T>
+            int FindVector(const T* data, int size, const T* literal, size_t length, const size_t rare[2]) const
+            {
+                const int lanes   = 16 / sizeof(T);
+                const int stride  = sizeof(T);
+                size_t    farthest = rare[0] > rare[1] ? rare[0] : rare[1];
+                __m128i   first[2];
+                __m128i   second[2];
+
+                Broadcast(data, literal[rare[0]], _ignoreCase, first[0], first[1]);
+                Broadcast(data, literal[rare[1]], _ignoreCase, second[0], second[1]);
+
+                int pos  = 0;
+                int last = size - static_cast<int>(length);
+                for(; pos <= last && pos + static_cast<int>(farthest) + lanes <= size; pos += lanes)
+                {
+                    __m128i a    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + rare[0]));
+                    __m128i b    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + rare[1]));
+                    __m128i hits = _mm_and_si128(_mm_or_si128(Equal(data, a, first[0]),  Equal(data, a, first[1])),
+                                                 _mm_or_si128(Equal(data, b, second[0]), Equal(data, b, second[1])));
+
+                    for(unsigned units = Units(data, hits); units; units &= units - 1)
+                    {
+                        unsigned long bit;
+                        _BitScanForward(&bit, units);
+
+                        int candidate = pos + static_cast<int>(bit) / stride;
+                        if(candidate <= last && Equals(data + candidate, literal, length))
+                            return candidate;
+                    }
+                }
+
+                return FindScalar(data, size, pos, literal, length);
+            }
+
+
+            template <typename T>
+            int Find(const T* data, int size, const T* literal, size_t length, const size_t rare[2]) const
+            {
+                if(!length)
+                    return size >= 0 ? 0 : -1;
+                return HasSSE2() ? FindVector(data, size, literal, length, rare) : FindScalar(data, size, 0, literal, length);
+            }
+
+
+            const unsigned char* Bytes() const
+            {
+                return reinterpret_cast<const unsigned char*>(_bytes.data());
+            }
+
+
+        public:
+
+            /* bytes is the literal in the encoding of the Regex. chars is nullptr unless that is UTF-8. */
+            SubstringSearch(const char* bytes, int byteLength, const wchar_t* chars, int charLength, bool ignoreCase)
+                : _bytes(bytes, byteLength), _hasChars(chars != nullptr), _ignoreCase(ignoreCase)
+            {
+                if(chars)
+                    _chars.assign(chars, charLength);
+
+                if(ignoreCase)
+                {
+                    for(size_t i = 0; i < _bytes.size(); ++i)
+                        _bytes[i] = static_cast<char>(Fold(static_cast<unsigned char>(_bytes[i])));
+                    for(size_t i = 0; i < _chars.size(); ++i)
+                        _chars[i] = static_cast<wchar_t>(Fold(_chars[i]));
+                }
+
+                ChooseRare(Bytes(), _bytes.size(), _rareBytes);
+                ChooseRare(_chars.data(), _chars.size(), _rareChars);
+            }
+
+
+            /* The length of the literal in bytes. */
+            int Length() const
+            {
+                return static_cast<int>(_bytes.size());
+            }
+
+
+            bool HasChars() const
+            {
+                return _hasChars;
+            }
+
+
+            /* Returns the offset in data of the first occurrence of the literal, or -1. */
+            int Find(const char* data, int size) const
+            {
+                return Find(reinterpret_cast<const unsigned char*>(data), size, Bytes(), _bytes.size(), _rareBytes);
+            }
+
+
+            /* As above, in chars. Only valid if HasChars(). */
+            int Find(const wchar_t* data, int size) const
+            {
+                return Find(data, size, _chars.data(), _chars.size(), _rareChars);
+            }
+
+
+            /* Whether the literal occurs at data, which must hold at least Length() bytes. */
+            bool IsAt(const char* data) const
+            {
+                return Equals(reinterpret_cast<const unsigned char*>(data), Bytes(), _bytes.size());
+            }
+    };
+
+
+    /*
+     *  Finds candidates for a pattern that is a sequence of items, one run of which is a literal every
+     *  match contains, e.g. "ing" in "[a-zA-Z]+ing". Regex::_search runs RE2 only around and after them.
+     *
+     *  A match that contains the literal at q starts no earlier than q - maxPrefix, and no earlier than
+     *  the run of bytes the items before the literal can match that ends at q. If no earlier candidate
+     *  had a match, no match starts before the first such bound, so an unanchored search from there
+     *  finds the leftmost match. Likewise it ends no later than q + length + maxSuffix, so when the
+     *  items after the literal are bounded, RE2 can test each candidate in a window of the input.
+     */
+    class InnerLiteral
+    {
+        private:
+
+            /*
+             *  _prefixBytes : The bytes the items before the literal can match.
+             *
+             *  _maxPrefix, _maxSuffix : The most bytes the items before and after the literal can match,
+             *                           or -1 if there's no limit.
+             */
+            SubstringSearch _literal;
+            bool            _prefixBytes[256];
+            int             _maxPrefix;
+            int             _maxSuffix;
+
+
+        public:
+
+            /* Beyond this many windows without a match, the rest of the input is searched at once. */
+            static const int MAX_WINDOWS = 8;
+
+            InnerLiteral(const std::string& literal, const bool prefixBytes[256], int maxPrefix, int maxSuffix)
+                : _literal(literal.data(), static_cast<int>(literal.size()), nullptr, 0, false), _maxPrefix(maxPrefix), _maxSuffix(maxSuffix)
+            {
+                memcpy(_prefixBytes, prefixBytes, sizeof(_prefixBytes));
+            }
+
+
+            /* Returns the position of the first occurrence of the literal in [start, end), or -1. */
+            int Find(const char* data, int start, int end) const
+            {
+                int offset = _literal.Find(data + start, end - start);
+                return offset < 0 ? -1 : start + offset;
+            }
+
+
+            /* Returns where a match containing the literal at q can start at the earliest. */
+            int WindowStart(const char* data, int start, int q) const
+            {
+                int lower = _maxPrefix >= 0 && q - _maxPrefix > start ? q - _maxPrefix : start;
+                while(q > lower && _prefixBytes[static_cast<unsigned char>(data[q - 1])])
+                    --q;
+                return q;
+            }
+
+
+            /* Returns where a match containing the literal at q can end at the latest. */
+            int WindowEnd(int q, int end) const
+            {
+                return _maxSuffix >= 0 && _maxSuffix < end - q - _literal.Length() ? q + _literal.Length() + _maxSuffix : end;
+            }
+    };
+
+    #pragma managed(pop)
+}
+}
\ No newline at end of file
@@ -24,6 +24,7 @@ namespace Net
         _groupcount = groupcount;
         _input      = input;
         _nextpos    = nextpos;
+        _groupmask  = -1;
     }
 
     Match^ Match::Empty::get()
@@ -56,7 +57,7 @@ namespace Net
         if(start > end)
             return Match::Empty;
 
-        return _regex->_match(this->Input, start, end - start, _index + (_length ? _length : 1));
+        return _regex->_match(this->Input, start, end - start, _index + (_length ? _length : 1), _groupmask);
     }
 
     //String^ Match::Result(String^ replacement)
@@ -44,6 +44,9 @@ namespace Net
             int              _groupcount;
             int              _nextpos;
 
+            /* The groups captured, for NextMatch(). See Regex::_match(). */
+            Int64            _groupmask;
+
             Match(Regex^ regex, int groupcount, RegexInput^ input, int begpos, int len, int nextpos);
 
             /*
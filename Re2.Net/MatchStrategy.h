@@ -0,0 +1,53 @@
+/*
+ *  Re2.Net Copyright  2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+
+namespace Re2
+{
+namespace Net
+{
+    /// <summary>
+    ///     Specifies how a <c>Regex</c> searches its input, as chosen from its pattern and options when it is created.
+    /// </summary>
+    /// <remarks>
+    ///     Every strategy finds the same matches. Only the work done to find them differs.
+    /// </remarks>
+    public enum class MatchStrategy
+    {
+        /// <summary>
+        ///     RE2 searches the whole input.
+        /// </summary>
+        Automaton,
+
+        /// <summary>
+        ///     The pattern is an alternation of plain literals, such as <c>Tom|Sawyer</c>. A vectorized scan finds where
+        ///     a match starts, and RE2 only matches from there.
+        /// </summary>
+        LiteralAlternation,
+
+        /// <summary>
+        ///     <c>RegexOptions.Literal</c> is set. The literal is searched for directly and RE2 is not used.
+        /// </summary>
+        Substring,
+
+        /// <summary>
+        ///     Every match contains a literal that doesn't start the pattern, such as "ing" in <c>[a-zA-Z]+ing</c>. A
+        ///     vectorized scan finds the literal, and RE2 only searches around and after it.
+        /// </summary>
+        InnerLiteral,
+
+        /// <summary>
+        ///     The pattern is a short sequence of characters and classes with a counted repetition, such as
+        ///     <c>a[^x]{20}b</c>, that would multiply RE2's DFA states. A bit-parallel matcher decides whether there is a
+        ///     match and where it starts, and RE2 only finds where it ends. In UTF-8 mode, input that isn't ASCII is left
+        ///     to RE2.
+        /// </summary>
+        BitParallel
+    };
+}
+}
\ No newline at end of file
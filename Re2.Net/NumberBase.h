@@ -0,0 +1,43 @@
+/*
+ *  Re2.Net Copyright  2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+
+namespace Re2
+{
+namespace Net
+{
+    /// <summary>
+    ///     Specifies how <c>Regex.TryExtract</c> reads integers from captured text.
+    /// </summary>
+    /// <remarks>
+    ///     The underlying values are the radixes that RE2 passes to <c>strtol</c>.
+    /// </remarks>
+    public enum class NumberBase
+    {
+        /// <summary>
+        ///     Reads base-10 integers.
+        /// </summary>
+        Decimal = 10,
+
+        /// <summary>
+        ///     Reads base-16 integers, with or without a leading "0x".
+        /// </summary>
+        Hex = 16,
+
+        /// <summary>
+        ///     Reads base-8 integers.
+        /// </summary>
+        Octal = 8,
+
+        /// <summary>
+        ///     Reads integers as C does: hexadecimal with a leading "0x", octal with a leading "0", and decimal otherwise.
+        /// </summary>
+        CRadix = 0
+    };
+}
+}
\ No newline at end of file
@@ -17,8 +17,12 @@
 
 #include <vcclr.h>
 #include "Regex.h"
+#include "LiteralSearch.h"
+#include "ShiftAnd.h"
 #include "RegexOptions.h"
 #include "RegexInput.h"
+#include "RegexTelemetry.h"
+#include "StringEncoding.h"
 #include "Match.h"
 #include "MatchCollection.h"
 
@@ -29,11 +33,24 @@ namespace Net
 {
     using namespace System;
 
+    using System::Collections::Concurrent::Partitioner;
     using System::Collections::Generic::Dictionary;
+    using System::Collections::Generic::IEnumerable;
+    using System::Collections::Generic::IList;
     using System::Collections::Generic::List;
+    using System::Diagnostics::Stopwatch;
+    using System::Globalization::CultureInfo;
+    using System::Globalization::NumberStyles;
     using System::Globalization::StringInfo;
+    using System::IO::File;
     using System::Text::Encoding;
     using System::Text::StringBuilder;
+    using System::Threading::Interlocked;
+    using System::Threading::Monitor;
+    using System::Threading::Tasks::Parallel;
+    using System::Threading::Tasks::Task;
+    using System::Threading::Tasks::ParallelLoopState;
+    using System::Threading::Tasks::ParallelOptions;
 
     using re2::RE2;
     using re2::StringPiece;
@@ -49,48 +66,13 @@ namespace Net
 
         #pragma managed(push, off)
 
+            /* The conversion kernels themselves are in StringEncoding.h. */
             static StringPiece* stringToUTF8(const wchar_t* chars, int length)
             {
-                /* 2 bytes of UTF-16 can require up to 3 bytes of UTF-8. */
                 char* utf8 = static_cast<char*>(malloc(length * 3));
                 if(ENOMEM == errno) return nullptr;
 
-                int size = 0;
-                for(int i = 0; i < length; ++i)
-                {
-                    wchar_t u = chars[i] - 0xd800;
-                    int     c;
-
-                    if(!((unsigned)u <= 0xdfff - 0xd800))
-                        c = chars[i];
-                    else
-                        c = u * 0x400 + chars[++i] + 0x2400;
-
-                    #pragma warning(disable:4244) 
-                    if(c < 0x0080)
-                    {
-                        utf8[size++] = static_cast<char>(c);
-                    }
-                    else if(c < 0x0800)
-                    {
-                        utf8[size++] = 0xc0 | (c >> 6);
-                        utf8[size++] = 0x80 | (c & 0x3f);
-                    }
-                    else if(c < 0x10000)
-                    {
-                        utf8[size++] = 0xe0 | (c >> 12);
-                        utf8[size++] = 0x80 | ((c >> 6) & 0x3f);
-                        utf8[size++] = 0x80 | (c & 0x3f);
-                    }
-                    else
-                    {
-                        utf8[size++] = 0xf0 | (c >> 18);
-                        utf8[size++] = 0x80 | ((c >> 12) & 0x3f);
-                        utf8[size++] = 0x80 | ((c >> 6) & 0x3f);
-                        utf8[size++] = 0x80 | (c & 0x3f);
-                    }
-                    #pragma warning(default:4244)
-                }
+                int size = stringToUTF8(chars, length, utf8);
 
                 /* The memory block shouldn't need to be moved, but it's possible. */
                 utf8 = static_cast<char*>(realloc(utf8, size));
@@ -99,6 +81,36 @@ namespace Net
                 return new StringPiece(utf8, size);
             }
 
+
+            /* A growable scratch buffer, reused across conversions by a single thread. */
+            struct ConversionBuffer
+            {
+                char* data;
+                int   capacity;
+
+                ConversionBuffer() : data(nullptr), capacity(0) { }
+
+                ~ConversionBuffer()
+                {
+                    free(data);
+                }
+
+                bool Reserve(int size)
+                {
+                    if(size <= capacity)
+                        return true;
+
+                    int   grown = capacity * 2 > size ? capacity * 2 : size;
+                    char* block = static_cast<char*>(realloc(data, grown ? grown : 1));
+                    if(!block)
+                        return false;
+
+                    data     = block;
+                    capacity = grown;
+                    return true;
+                }
+            };
+
         #pragma managed(pop)
 
         static StringPiece* StringToUTF8(String^ string)
@@ -110,42 +122,32 @@ namespace Net
         }
 
 
-        static StringPiece* StringToASCII(String^ string, String^ argument)
+        static StringPiece* StringToSingleByte(String^ string, String^ argument, wchar_t max, String^ encoding)
         {
-            array<Byte>^ bytes = Encoding::ASCII->GetBytes(string);
-            if(string != Encoding::ASCII->GetString(bytes))
-                throw gcnew ArgumentOutOfRangeException(argument, "Specified argument was out of the range of valid ASCII values.");
-            pin_ptr<Byte> pinptr = &bytes[0];
-            char* copy = static_cast<char*>(malloc(bytes->Length));
+            char* copy = static_cast<char*>(malloc(string->Length));
             if(ENOMEM == errno)
                 throw gcnew OutOfMemoryException();
-            memcpy(copy, pinptr, bytes->Length);
-            return new StringPiece(copy, bytes->Length);
+
+            pin_ptr<const wchar_t> chars = PtrToStringChars(string);
+            if(!stringToSingleByte(chars, string->Length, copy, max))
+            {
+                free(copy);
+                throw gcnew ArgumentOutOfRangeException(argument,
+                    String::Format("Specified argument was out of the range of valid {0} values.", encoding));
+            }
+            return new StringPiece(copy, string->Length);
+        }
+
+
+        static StringPiece* StringToASCII(String^ string, String^ argument)
+        {
+            return StringToSingleByte(string, argument, 0x7f, "ASCII");
         }
 
 
-        /*
-         *  The Latin-1 code page is available on systems with the full .NET Framework or the
-         *  .NET Framework Client Profile, but it may not be available on mobile or embedded
-         *  devices using the .NET Compact Framework.
-         *
-         *  See: http://msdn.microsoft.com/en-us/library/x5b31f9d.aspx
-         */
         static StringPiece* StringToLatin1(String^ string, String^ argument)
         {
-            Encoding^    Latin1 = Encoding::GetEncoding("ISO-8859-1");
-            array<Byte>^ bytes  = Latin1->GetBytes(string);
-            if(string != Latin1->GetString(bytes))
-            {
-                throw gcnew ArgumentOutOfRangeException(argument,
-                    "Specified argument was out of the range of valid Latin-1 values.");
-            }
-            pin_ptr<Byte> pinptr = &bytes[0];
-            char* copy = static_cast<char*>(malloc(bytes->Length));
-            if(ENOMEM == errno)
-                throw gcnew OutOfMemoryException();
-            memcpy(copy, pinptr, bytes->Length);
-            return new StringPiece(copy, bytes->Length);
+            return StringToSingleByte(string, argument, 0xff, "Latin-1");
         }
 
 
@@ -173,150 +175,284 @@ namespace Net
                                                                             StringToUTF8(string);
         }
 
-    #pragma endregion
 
+        /*
+         *  As above, but converts into a reusable buffer rather than allocating a new one.
+         *  Returns the number of bytes written.
+         */
+        static int ConvertStringEncoding(String^ string, String^ source, RegexOptions options, ConversionBuffer* buffer)
+        {
+            bool isLatin1 = RegexOption::HasAnyFlag(options, RegexOptions::Latin1);
+            bool isASCII  = RegexOption::HasAnyFlag(options, RegexOptions::ASCII);
+            int  length   = string->Length;
+
+            if(!buffer->Reserve(isLatin1 || isASCII ? length : length * 3))
+                throw gcnew OutOfMemoryException();
+            if(!length)
+                return 0;
 
-    #pragma region Encoding length functions
+            pin_ptr<const wchar_t> chars = PtrToStringChars(string);
+            if(!isLatin1 && !isASCII)
+                return stringToUTF8(chars, length, buffer->data);
 
-        #pragma managed(push, off)
+            /* Latin1 overrides ASCII if both are set. */
+            if(!stringToSingleByte(chars, length, buffer->data, isLatin1 ? 0xff : 0x7f))
+            {
+                throw gcnew ArgumentOutOfRangeException(source,
+                    String::Format("Specified argument was out of the range of valid {0} values.", isLatin1 ? "Latin-1" : "ASCII"));
+            }
+            return length;
+        }
 
-        /*
-         *  Counts the number of chars in a UTF-8 sequence. This is necessary because the
-         *  Index of a Capture, Group, or Match is reported in terms of the entire input,
-         *  regardless of startIndex or length.
-         */
-        static int StrToCharPos(const char* input, int utf16_length)
+    #pragma endregion
+
+
+    #pragma region Regex cache
+
+        void Regex::Cache::Size::set(int value)
         {
-            int rv = 0;
-            for(int i = 0; i < utf16_length; ++i)
+            Monitor::Enter(_lock);
+            try
             {
-                /* 0b1xxxxxxx marks the start of a UTF-8 sequence. */
-                if((input[rv] & 0x80))
-                {
-                    if((input[rv] & 0xe0) == 0xc0)
-                    {
-                        rv += 2;
-                    }
-                    else if((input[rv] & 0xf0) == 0xe0)
-                    {
-                        rv += 3;
-                    }
-                    else if((input[rv] & 0xf8) == 0xf0)
+                /* Remove older expressions when shrinking the cache size. */
+                if(value < _size)
+                    while(_list.Count > value)
                     {
-                        rv += 4;
-                        /*
-                         *  .NET strings are counted in UTF-16 code units, not Unicode code
-                         *  points. The two differ only outside the BMP, i.e. this case.
-                         *
-                         *  Since StrToCharPos goes by .NET string length, i is double-
-                         *  incremented to include both UTF-16 surrogates.
-                         */
-                        i++;
+                        Regex^ temp = _list[0];
+                        _list.RemoveAt(0);
+                        /* Using the full 32-bit enum value keeps Pattern + Options collision-proof. */
+                        _map.Remove(temp->Pattern + static_cast<int>(temp->Options).ToString("X8"));
                     }
-                }
-                else rv++;
+
+                _size = value;
+            }
+            finally
+            {
+                Monitor::Exit(_lock);
             }
-            return rv;
         }
-        
 
-        /*
-         *  Counts the number of UTF-8 characters in a char sequence. This is necessary
-         *  because the Index of a Capture, Group, or Match is reported in terms of the
-         *  entire input, regardless of startIndex or length.
-         */
-        static int CharToStrPos(const char* input, int char_length)
+
+        void Regex::Cache::_add(String^ key, Regex^ regex)
         {
-            int rv = 0;
-            for(int i = 0; i < char_length; ++rv)
+            if(_size <= 0)
+                return;
+
+            Regex^ prior;
+            if(_map.TryGetValue(key, prior))
+                _list.Remove(prior);
+            else if(_list.Count >= _size)
+            {
+                Regex^ temp = _list[0];
+                _list.RemoveAt(0);
+                _map.Remove(temp->Pattern + static_cast<int>(temp->Options).ToString("X8"));
+            }
+
+            _list.Add(regex);
+            _map[key] = regex;
+        }
+
+
+        Regex^ Regex::Cache::FindOrCreate(String^ pattern, RegexOptions options)
+        {
+            Regex^  regex = nullptr;
+            String^ key   = pattern + static_cast<int>(options).ToString("X8");
+
+            Monitor::Enter(_lock);
+            try
             {
-                /* 0b1xxxxxxx marks the start of a UTF-8 sequence. */
-                if((input[i] & 0x80))
+                if(_recording)
                 {
-                    if((input[i] & 0xe0) == 0xc0)
-                    {
-                        i += 2;
-                    }
-                    else if((input[i] & 0xf0) == 0xe0)
-                    {
-                        i += 3;
-                    }
-                    else if((input[i] & 0xf8) == 0xf0)
+                    Int64 count = 0;
+                    _usage.TryGetValue(key, count);
+                    _usage[key] = count + 1;
+                }
+
+                if(_map.TryGetValue(key, regex))
+                {
+                    int i = _list.LastIndexOf(regex);
+                    if(i != _list.Count - 1)
                     {
-                        i += 4;
-                        /*
-                         *  .NET strings are counted in UTF-16 code units, not Unicode code
-                         *  points. The two differ only outside the BMP, i.e. this case.
-                         *
-                         *  Since CharToStrPos goes by C string length, rv is double-
-                         *  incremented to include both UTF-16 surrogates.
-                         */
-                        rv++;
+                        _list.RemoveAt(i);
+                        _list.Add(regex);
                     }
-                    // else ...
-                    /* Input must be valid UTF-8 or i never increments. */
+
+                    return regex;
                 }
-                else i++;
             }
-            return rv;
+            finally
+            {
+                Monitor::Exit(_lock);
+            }
+
+            /* Compiled outside the lock, so that one slow pattern doesn't hold up every other caller. */
+            regex = gcnew Regex(pattern, options);
+
+            Monitor::Enter(_lock);
+            try
+            {
+                /* Another thread may have compiled the same pattern in the meantime. Theirs wins. */
+                Regex^ cached;
+                if(_map.TryGetValue(key, cached))
+                    return cached;
+
+                _add(key, regex);
+            }
+            finally
+            {
+                Monitor::Exit(_lock);
+            }
+
+            return regex;
         }
 
-        #pragma managed(pop)
 
-    #pragma endregion
+        void Regex::Cache::Add(Regex^ regex)
+        {
+            String^ key = regex->Pattern + static_cast<int>(regex->Options).ToString("X8");
 
+            Monitor::Enter(_lock);
+            try
+            {
+                _add(key, regex);
+            }
+            finally
+            {
+                Monitor::Exit(_lock);
+            }
+        }
 
-    #pragma region Regex cache
 
-        void Regex::Cache::Size::set(int value)
+        bool Regex::Cache::Recording::get()
         {
-            /* Remove older expressions when shrinking the cache size. */
-            if(value < _size)
-                while(_list.Count > value)
-                {
-                    Regex^ temp = _list[0];
-                    _list.RemoveAt(0);
-                    /* Using the full 32-bit enum value keeps Pattern + Options collision-proof. */
-                    _map.Remove(temp->Pattern + static_cast<int>(temp->Options).ToString("X8"));
-                }
+            return _recording;
+        }
+
 
-            _size = value;
+        void Regex::Cache::Recording::set(bool value)
+        {
+            _recording = value;
         }
 
 
-        Regex^ Regex::Cache::FindOrCreate(String^ pattern, RegexOptions options)
+        void Regex::Cache::Save(String^ path)
         {
-            Regex^  regex = nullptr;
-            String^ key   = pattern + static_cast<int>(options).ToString("X8");
+            array<String^>^ keys;
+            array<Int64>^   counts;
 
-            if(_map.ContainsKey(key))
+            Monitor::Enter(_lock);
+            try
             {
-                regex = _map[key];
-                int i = _list.LastIndexOf(regex);
-                if(i != _list.Count - 1)
-                {
-                    _list.RemoveAt(i);
-                    _list.Add(regex);
-                }
+                keys   = gcnew array<String^>(_usage.Count);
+                counts = gcnew array<Int64>(_usage.Count);
+                _usage.Keys->CopyTo(keys, 0);
+                _usage.Values->CopyTo(counts, 0);
             }
-            else
+            finally
             {
-                if(_size > 0 && _list.Count >= _size)
-                {
-                    Regex^ temp = _list[0];
-                    _list.RemoveAt(0);
-                    _map.Remove(temp->Pattern + static_cast<int>(temp->Options).ToString("X8"));
-                }
+                Monitor::Exit(_lock);
+            }
+
+            /* Ascending, so the lines are written back to front. */
+            Array::Sort(counts, keys);
+
+            StringBuilder^ manifest = gcnew StringBuilder();
+            for(int i = keys->Length - 1; i >= 0; i--)
+            {
+                /* A key is the pattern followed by the options as eight hex digits. See FindOrCreate. */
+                String^ key     = keys[i];
+                String^ pattern = key->Substring(0, key->Length - 8);
+
+                manifest->Append(counts[i].ToString(CultureInfo::InvariantCulture))->Append(L'\t')
+                        ->Append(key, key->Length - 8, 8)->Append(L'\t')
+                        ->Append(pattern->Replace("%", "%25")->Replace("\r", "%0D")->Replace("\n", "%0A"))->Append(L'\n');
+            }
+
+            File::WriteAllText(path, manifest->ToString(), Encoding::UTF8);
+        }
+
 
-                regex = gcnew Regex(pattern, options);
-                if(_size > 0)
+        Task^ Regex::Cache::Load(String^ path, int maxEntries)
+        {
+            if(!File::Exists(path))
+                return Task::FromResult<bool>(true);
+
+            array<String^>^ lines  = File::ReadAllLines(path, Encoding::UTF8);
+            array<String^>^ keys   = gcnew array<String^>(lines->Length);
+            array<Int64>^   counts = gcnew array<Int64>(lines->Length);
+            int             length = 0;
+
+            for(int i = 0; i < lines->Length; i++)
+            {
+                if(!lines[i]->Length)
+                    continue;
+
+                array<String^>^ fields = lines[i]->Split(gcnew array<wchar_t>{ L'\t' }, 3);
+                Int64           count;
+                int             options;
+
+                if(fields->Length != 3 || fields[1]->Length != 8
+                   || !Int64::TryParse(fields[0], NumberStyles::None, CultureInfo::InvariantCulture, count)
+                   || !Int32::TryParse(fields[1], NumberStyles::AllowHexSpecifier, CultureInfo::InvariantCulture, options))
+                    throw gcnew FormatException(String::Format("Invalid cache manifest entry on line {0} of '{1}'.", i + 1, path));
+
+                /* Every '%' in a written pattern starts an escape, so "%25" has to be decoded last. */
+                String^ pattern = fields[2]->Replace("%0A", "\n")->Replace("%0D", "\r")->Replace("%25", "%");
+
+                keys[length]   = pattern + fields[1]->ToUpperInvariant();
+                counts[length] = count;
+                length++;
+            }
+
+            Monitor::Enter(_lock);
+            try
+            {
+                for(int i = 0; i < length; i++)
                 {
-                    _list.Add(regex);
-                    _map[key] = regex;
+                    Int64 count = 0;
+                    _usage.TryGetValue(keys[i], count);
+                    _usage[keys[i]] = count + counts[i];
                 }
+
+                maxEntries = Math::Min(maxEntries, _size);
+            }
+            finally
+            {
+                Monitor::Exit(_lock);
             }
 
-            return regex;
+            /*
+             *  The most used entries are taken in ascending order, so that CompileAll adds the
+             *  most used last and the cache evicts them last.
+             */
+            Array::Sort(counts, keys, 0, length);
+
+            List<Tuple<String^, RegexOptions, int>^>^ definitions = gcnew List<Tuple<String^, RegexOptions, int>^>();
+            for(int i = Math::Max(0, length - maxEntries); i < length; i++)
+            {
+                String^ key = keys[i];
+                definitions->Add(gcnew Tuple<String^, RegexOptions, int>(key->Substring(0, key->Length - 8),
+                                                                         static_cast<RegexOptions>(Int32::Parse(key->Substring(key->Length - 8), NumberStyles::AllowHexSpecifier)),
+                                                                         /* #defined in re2.h, as used by FindOrCreate */ kDefaultMaxMem));
+            }
+
+            if(!definitions->Count)
+                return Task::FromResult<bool>(true);
+
+            return Task::Run(gcnew Action(gcnew Preload(definitions), &Preload::Run));
+        }
+
+
+        Regex::Cache::Preload::Preload(List<Tuple<String^, RegexOptions, int>^>^ definitions)
+            : _definitions(definitions)
+        { }
+
+
+        void Regex::Cache::Preload::Run()
+        {
+            /* Entries that no longer compile, e.g. after a change of options, are left out of the cache. */
+            array<String^>^ errors;
+            Regex::CompileAll(_definitions, errors, true);
         }
 
 
@@ -333,6 +469,44 @@ namespace Net
             Cache::Size = value;
         }
 
+
+        bool Regex::RecordCacheUsage::get()
+        {
+            return Cache::Recording;
+        }
+
+
+        void Regex::RecordCacheUsage::set(bool value)
+        {
+            Cache::Recording = value;
+        }
+
+
+        void Regex::SaveCacheManifest(String^ path)
+        {
+            if(!path)
+                throw gcnew ArgumentNullException("path", "Value cannot be null.");
+
+            Cache::Save(path);
+        }
+
+
+        Task^ Regex::LoadCacheManifest(String^ path, int maxEntries)
+        {
+            if(!path)
+                throw gcnew ArgumentNullException("path", "Value cannot be null.");
+            if(maxEntries < 0)
+                throw gcnew ArgumentOutOfRangeException("maxEntries");
+
+            return Cache::Load(path, maxEntries);
+        }
+
+
+        Task^ Regex::LoadCacheManifest(String^ path)
+        {
+            return Regex::LoadCacheManifest(path, Int32::MaxValue);
+        }
+
     #pragma endregion
 
 
@@ -356,6 +530,127 @@ namespace Net
         }
 
 
+        int Regex::ReplicaCount::get()
+        {
+            return _replicas ? _replicaCount : 1;
+        }
+
+
+        Int64 Regex::MemoryBudget::get()
+        {
+            return static_cast<Int64>(_maxMemory) * this->ReplicaCount;
+        }
+
+
+        MatchStrategy Regex::Strategy::get()
+        {
+            return _substring ? MatchStrategy::Substring          :
+                   _literals  ? MatchStrategy::LiteralAlternation :
+                   _inner     ? MatchStrategy::InnerLiteral       :
+                   _shiftAnd  ? MatchStrategy::BitParallel        :
+                                MatchStrategy::Automaton;
+        }
+
+
+        int Regex::ProgramSize::get()
+        {
+            int size = _re2->ProgramSize();
+
+            /* See _search(). */
+            GC::KeepAlive(this);
+
+            return size;
+        }
+
+
+        int Regex::CapturingGroupCount::get()
+        {
+            int count = _re2->NumberOfCapturingGroups();
+            GC::KeepAlive(this);
+            return count;
+        }
+
+
+        String^ Regex::RequiredPrefix::get()
+        {
+            string min;
+            string max;
+            bool   bounded = _re2->PossibleMatchRange(&min, &max, 64);
+            GC::KeepAlive(this);
+
+            if(!bounded)
+                return String::Empty;
+
+            /* Every match lies between min and max, so it starts with whatever they have in common. */
+            size_t length = 0;
+            while(length < min.size() && length < max.size() && min[length] == max[length])
+                length++;
+
+            bool isUtf8 = !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING);
+            if(isUtf8 && length)
+            {
+                /* Don't split a character: drop the last one if it isn't all there. */
+                size_t lead = length - 1;
+                while(lead > 0 && (static_cast<unsigned char>(min[lead]) & 0xC0) == 0x80)
+                    lead--;
+
+                unsigned char first  = static_cast<unsigned char>(min[lead]);
+                size_t        needed = first < 0x80 ? 1 : first >= 0xF0 ? 4 : first >= 0xE0 ? 3 : 2;
+                if(lead + needed > length)
+                    length = lead;
+            }
+
+            return CharToString(min.substr(0, length), isUtf8);
+        }
+
+
+        RegexTelemetry^ Regex::Telemetry::get()
+        {
+            return _telemetry;
+        }
+
+
+        const RE2* Regex::_engine()
+        {
+            if(!_replicas)
+                return _re2;
+
+            /*
+             *  Threads take tickets in the order they first match, and tickets map onto slots
+             *  round-robin. Past one thread per processor, threads start sharing replicas again,
+             *  which is no worse than sharing _re2.
+             */
+            int ticket = _threadSlot;
+            if(!ticket)
+                _threadSlot = ticket = Interlocked::Increment(_threadCount);
+
+            int    slot    = static_cast<int>(static_cast<unsigned int>(ticket - 1) % _replicas->Length);
+            IntPtr replica = _replicas[slot];
+            if(replica == IntPtr::Zero)
+                replica = this->_replicate(slot);
+
+            return static_cast<const RE2*>(replica.ToPointer());
+        }
+
+
+        IntPtr Regex::_replicate(int slot)
+        {
+            /* pattern() already carries the inline flags, and options() the encoding and memory limit. */
+            RE2*   replica = new RE2(_re2->pattern(), _re2->options());
+            IntPtr prior   = Interlocked::CompareExchange(_replicas[slot], IntPtr(replica), IntPtr::Zero);
+
+            /* Another thread on the same slot got there first. */
+            if(prior != IntPtr::Zero)
+            {
+                delete replica;
+                return prior;
+            }
+
+            Interlocked::Increment(_replicaCount);
+            return IntPtr(replica);
+        }
+
+
         String^ Regex::ToString()
         {
             return this->Pattern;
@@ -396,292 +691,2259 @@ namespace Net
             if(startIndex < 0 || startIndex > input->Length)
                 throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
 
-            StringPiece* sp = ConvertStringEncoding(input, "input", this->Options);
-            bool         rv = _re2->Match(*sp, startIndex, sp->length(), RE2::UNANCHORED, NULL, 0);
-            
-            free(const_cast<char*>(sp->data()));
-            delete sp;
-            
-            return rv;
+            /*
+             *  A literal can be found in the string's own chars, without converting it at all. Input with
+             *  a lone surrogate is searched as bytes, the way Match searches it, so that the two agree.
+             */
+            if(_substring && _substring->HasChars())
+            {
+                Int64 started = _telemetry ? Stopwatch::GetTimestamp() : 0;
+
+                pin_ptr<const wchar_t> chars = PtrToStringChars(input);
+                if(!hasLoneSurrogate(chars, input->Length))
+                {
+                    bool rv = _substring->Find(chars + startIndex, input->Length - startIndex) >= 0;
+                    GC::KeepAlive(this);
+
+                    if(_telemetry)
+                        _telemetry->_searched(2 * (input->Length - startIndex), rv, Stopwatch::GetTimestamp() - started);
+                    return rv;
+                }
+            }
+
+            Int64        started = _telemetry ? Stopwatch::GetTimestamp() : 0;
+            StringPiece* sp      = ConvertStringEncoding(input, "input", this->Options);
+
+            /* In UTF-8 mode, startIndex counts UTF-16 chars, not bytes. */
+            if(startIndex && !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING))
+                startIndex = StrToCharPos(sp->data(), startIndex);
+
+            if(_telemetry)
+                _telemetry->_converted(Stopwatch::GetTimestamp() - started);
+
+            bool rv = this->_search(sp->data(), sp->length(), startIndex, sp->length(), NULL, 0);
+            
+            free(const_cast<char*>(sp->data()));
+            delete sp;
+            
+            return rv;
+        }
+
+
+        bool Regex::IsMatch(array<Byte>^ input, int startIndex)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(startIndex < 0 || startIndex > input->Length)
+                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
+
+            return this->_search(input, startIndex, input->Length, NULL, 0, RE2::UNANCHORED);
+        }
+
+
+        bool Regex::IsMatch(String^ input)
+        {
+            return this->IsMatch(input, 0);
+        }
+
+
+        bool Regex::IsMatch(array<Byte>^ input)
+        {
+            return this->IsMatch(input, 0);
+        }
+
+
+        bool Regex::IsMatch(String^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->IsMatch(input);
+        }
+
+
+        bool Regex::IsMatch(array<Byte>^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->IsMatch(input);
+        }
+
+
+        bool Regex::IsMatch(String^ input, String^ pattern)
+        {
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->IsMatch(input);
+        }
+
+
+        bool Regex::IsMatch(array<Byte>^ input, String^ pattern)
+        {
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->IsMatch(input);
+        }
+
+        #pragma endregion
+
+
+        #pragma region FullMatch and PrefixMatch
+
+        bool Regex::_anchoredMatch(String^ input, int startIndex, int length, RE2::Anchor anchor)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(startIndex < 0 || startIndex > input->Length)
+                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
+            if(length < 0 || length > input->Length)
+                throw gcnew ArgumentOutOfRangeException("length", "Length cannot be less than 0 or greater than input length.");
+            if(startIndex + length > input->Length)
+                throw gcnew ArgumentOutOfRangeException("startIndex, length", "Start index and length combined cannot be greater than input length.");
+            if(startIndex < input->Length && Char::IsLowSurrogate(input[startIndex]))
+                throw gcnew ArgumentException("Start index cannot bisect a UTF-16 surrogate pair.", "startIndex");
+
+            Int64        started = _telemetry ? Stopwatch::GetTimestamp() : 0;
+            StringPiece* sp      = ConvertStringEncoding(input, "input", this->Options);
+            int          end     = startIndex + length;
+
+            /* In UTF-8 mode, startIndex and length count UTF-16 chars, not bytes. */
+            if(!RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING))
+            {
+                if(startIndex) startIndex = StrToCharPos(sp->data(), startIndex);
+                end = startIndex + StrToCharPos(sp->data() + startIndex, length);
+            }
+
+            if(_telemetry)
+                _telemetry->_converted(Stopwatch::GetTimestamp() - started);
+
+            bool rv = this->_search(sp->data(), sp->length(), startIndex, end, NULL, 0, anchor);
+
+            free(const_cast<char*>(sp->data()));
+            delete sp;
+
+            return rv;
+        }
+
+
+        bool Regex::_anchoredMatch(array<Byte>^ input, int startIndex, int length, RE2::Anchor anchor)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(startIndex < 0 || startIndex > input->Length)
+                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
+            if(length < 0 || length > input->Length)
+                throw gcnew ArgumentOutOfRangeException("length", "Length cannot be less than 0 or greater than input length.");
+            if(startIndex + length > input->Length)
+                throw gcnew ArgumentOutOfRangeException("startIndex, length", "Start index and length combined cannot be greater than input length.");
+
+            return this->_search(input, startIndex, startIndex + length, NULL, 0, anchor);
+        }
+
+
+
+        bool Regex::FullMatch(String^ input, int startIndex, int length)
+        {
+            return this->_anchoredMatch(input, startIndex, length, RE2::ANCHOR_BOTH);
+        }
+
+
+        bool Regex::FullMatch(array<Byte>^ input, int startIndex, int length)
+        {
+            return this->_anchoredMatch(input, startIndex, length, RE2::ANCHOR_BOTH);
+        }
+
+
+        bool Regex::FullMatch(String^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            return this->_anchoredMatch(input, 0, input->Length, RE2::ANCHOR_BOTH);
+        }
+
+
+        bool Regex::FullMatch(array<Byte>^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            return this->_anchoredMatch(input, 0, input->Length, RE2::ANCHOR_BOTH);
+        }
+
+
+        bool Regex::FullMatch(String^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->FullMatch(input);
+        }
+
+
+        bool Regex::FullMatch(array<Byte>^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->FullMatch(input);
+        }
+
+
+        bool Regex::FullMatch(String^ input, String^ pattern)
+        {
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->FullMatch(input);
+        }
+
+
+        bool Regex::FullMatch(array<Byte>^ input, String^ pattern)
+        {
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->FullMatch(input);
+        }
+
+
+        bool Regex::PrefixMatch(String^ input, int startIndex, int length)
+        {
+            return this->_anchoredMatch(input, startIndex, length, RE2::ANCHOR_START);
+        }
+
+
+        bool Regex::PrefixMatch(array<Byte>^ input, int startIndex, int length)
+        {
+            return this->_anchoredMatch(input, startIndex, length, RE2::ANCHOR_START);
+        }
+
+
+        bool Regex::PrefixMatch(String^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            return this->_anchoredMatch(input, 0, input->Length, RE2::ANCHOR_START);
+        }
+
+
+        bool Regex::PrefixMatch(array<Byte>^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            return this->_anchoredMatch(input, 0, input->Length, RE2::ANCHOR_START);
+        }
+
+
+        bool Regex::PrefixMatch(String^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->PrefixMatch(input);
+        }
+
+
+        bool Regex::PrefixMatch(array<Byte>^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->PrefixMatch(input);
+        }
+
+
+        bool Regex::PrefixMatch(String^ input, String^ pattern)
+        {
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->PrefixMatch(input);
+        }
+
+
+        bool Regex::PrefixMatch(array<Byte>^ input, String^ pattern)
+        {
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->PrefixMatch(input);
+        }
+
+        #pragma endregion
+
+
+        #pragma region Match
+
+        int Regex::_groupCount()
+        {
+            return RegexOption::HasAnyFlag(this->Options, RegexOptions::SingleCapture) ? 1 : 1 + _re2->NumberOfCapturingGroups();
+        }
+
+
+        int Regex::_groupCount(Int64 groupMask)
+        {
+            int count = this->_groupCount();
+            if(groupMask == -1)
+                return count;
+
+            /* Submatches are numbered, so RE2 has to be asked for every group up to the last one selected. */
+            for(int i = Math::Min(count - 1, 63); i > 0; i--)
+                if((groupMask >> i) & 1)
+                    return i + 1;
+            return 1;
+        }
+
+
+        bool Regex::_search(const char* data, int size, int startIndex, int endIndex, StringPiece* captures, int groupCount)
+        {
+            return this->_search(data, size, startIndex, endIndex, captures, groupCount, RE2::UNANCHORED);
+        }
+
+
+        bool Regex::_search(const char* data, int size, int startIndex, int endIndex, StringPiece* captures, int groupCount, RE2::Anchor anchor)
+        {
+            if(!_telemetry)
+                return this->_find(data, size, startIndex, endIndex, captures, groupCount, anchor);
+
+            Int64 started = Stopwatch::GetTimestamp();
+            bool  rv      = this->_find(data, size, startIndex, endIndex, captures, groupCount, anchor);
+            _telemetry->_searched(Math::Max(0, endIndex - startIndex), rv, Stopwatch::GetTimestamp() - started);
+
+            return rv;
+        }
+
+
+        /*
+         *  Pins input for the search only. An empty array can still match an empty pattern, but it has
+         *  no first element to pin, so it's searched as a null pointer. Captures point into the array,
+         *  which the GC may move once it's unpinned, so a caller that builds a Match from them pins the
+         *  array itself, in the same way.
+         */
+        bool Regex::_search(array<Byte>^ input, int startIndex, int endIndex, StringPiece* captures, int groupCount, RE2::Anchor anchor)
+        {
+            pin_ptr<Byte> bytes = nullptr;
+            if(input->Length)
+                bytes = &input[0];
+
+            return this->_search((const char*)bytes, input->Length, startIndex, endIndex, captures, groupCount, anchor);
+        }
+
+
+        bool Regex::_find(const char* data, int size, int startIndex, int endIndex, StringPiece* captures, int groupCount, RE2::Anchor anchor)
+        {
+            /* A Literal pattern has no groups, so its one capture is wherever the literal is found. */
+            if(_substring)
+            {
+                int length = _substring->Length();
+                int offset = -1;
+
+                if(startIndex <= endIndex)
+                {
+                    if(anchor == RE2::UNANCHORED)
+                        offset = _substring->Find(data + startIndex, endIndex - startIndex);
+                    else if(anchor == RE2::ANCHOR_START ? endIndex - startIndex >= length : endIndex - startIndex == length)
+                        offset = _substring->IsAt(data + startIndex) ? 0 : -1;
+                }
+
+                if(offset >= 0 && groupCount)
+                    captures[0] = StringPiece(data + startIndex + offset, length);
+
+                GC::KeepAlive(this);
+                return offset >= 0;
+            }
+
+            /*
+             *  A literal alternation's leftmost match starts where the first of its literals occurs.
+             *  RE2, anchored there, only has to pick the alternative and fill in the captures.
+             */
+            if(_literals && anchor == RE2::UNANCHORED && startIndex <= endIndex)
+            {
+                int offset = _literals->Find(data + startIndex, endIndex - startIndex);
+                if(offset < 0 || !groupCount)
+                {
+                    GC::KeepAlive(this);
+                    return offset >= 0;
+                }
+
+                startIndex += offset;
+                anchor      = RE2::ANCHOR_START;
+            }
+
+            /*
+             *  With an inner literal, RE2 tests a window around each occurrence until one holds a match.
+             *  The leftmost match starts no earlier than that window, so the search proper starts there.
+             *  See InnerLiteral in LiteralSearch.h.
+             */
+            if(_inner && anchor == RE2::UNANCHORED && startIndex <= endIndex)
+            {
+                const RE2* engine = this->_engine();
+                for(int from = startIndex, windows = 0; ; )
+                {
+                    int q = _inner->Find(data, from, endIndex);
+                    if(q < 0)
+                    {
+                        GC::KeepAlive(this);
+                        return false;
+                    }
+
+                    int windowStart = _inner->WindowStart(data, startIndex, q);
+                    int windowEnd   = windows++ < InnerLiteral::MAX_WINDOWS ? _inner->WindowEnd(q, endIndex) : endIndex;
+
+                    if(windowEnd == endIndex)
+                    {
+                        startIndex = windowStart;
+                        break;
+                    }
+                    if(engine->Match(StringPiece(data, size), windowStart, windowEnd, RE2::UNANCHORED, nullptr, 0))
+                    {
+                        if(!groupCount)
+                        {
+                            GC::KeepAlive(this);
+                            return true;
+                        }
+                        startIndex = windowStart;
+                        break;
+                    }
+                    from = q + 1;
+                }
+            }
+
+            /*
+             *  The bit-parallel matcher doesn't know which of several matches from the same start RE2's
+             *  priorities pick, so RE2 still finds where a match ends, anchored where it starts.
+             */
+            if(_shiftAnd && groupCount <= 1 && startIndex <= endIndex)
+            {
+                int start = -1;
+                int found = _shiftAnd->Search(data, size, startIndex, endIndex, anchor != RE2::UNANCHORED, anchor == RE2::ANCHOR_BOTH, groupCount ? &start : nullptr);
+                if(!found || (found > 0 && !groupCount))
+                {
+                    GC::KeepAlive(this);
+                    return found > 0;
+                }
+                if(start >= 0)
+                {
+                    startIndex = start;
+                    anchor     = anchor == RE2::ANCHOR_BOTH ? RE2::ANCHOR_BOTH : RE2::ANCHOR_START;
+                }
+            }
+
+            bool rv = this->_engine()->Match(StringPiece(data, size), startIndex, endIndex, anchor, captures, groupCount);
+
+            /* _re2 and its replicas belong to _handle, which mustn't be finalized mid-search. */
+            GC::KeepAlive(this);
+
+            return rv;
+        }
+
+
+        RegexInput^ Regex::_convert(String^ input, String^ argument, RegexOptions options)
+        {
+            StringPiece* sp = ConvertStringEncoding(input, argument, options);
+            RegexInput^  rv = gcnew RegexInput(input, sp->data(), sp->length(), !RegexOption::HasAnyFlag(options, SINGLE_BYTE_ENCODING));
+            delete sp;
+
+            return rv;
+        }
+
+
+        /*
+         *  Finds the String index and length of a capture, or its byte offset and length if the
+         *  input isn't a UTF-8 String. ticks, if given, adds up the time spent in CharToStrPos.
+         */
+        static void LocateCapture(const char* base, const StringPiece& capture, bool isUtf8, int startIndex, int strStartIndex,
+                                  int& inputIndex, int& length, Int64* ticks)
+        {
+            int   charOffset = static_cast<int>(capture.data() - base);
+            Int64 started    = ticks ? Stopwatch::GetTimestamp() : 0;
+
+            inputIndex = isUtf8 && charOffset ? CharToStrPos(base + startIndex, charOffset - startIndex) + strStartIndex : charOffset;
+            length     = isUtf8 ? CharToStrPos(capture.data(), capture.length()) : capture.length();
+
+            if(ticks)
+                *ticks += Stopwatch::GetTimestamp() - started;
+        }
+
+
+        _Match^ Regex::_create(RegexInput^ input, const char* base, StringPiece* captures, int groupCount, int startIndex, int strStartIndex)
+        {
+            return this->_create(input, base, captures, groupCount, startIndex, strStartIndex, -1);
+        }
+
+
+        _Match^ Regex::_create(RegexInput^ input, const char* base, StringPiece* captures, int groupCount, int startIndex, int strStartIndex, Int64 groupMask)
+        {
+            /* Ignore the encoding of byte array and unmanaged memory inputs. */
+            bool   isUtf8        = input->IsString && input->IsUTF8;
+            Int64  started       = _telemetry ? Stopwatch::GetTimestamp() : 0;
+            Int64  positionTicks = 0;
+            Int64* ticks         = _telemetry && isUtf8 ? &positionTicks : nullptr;
+            int    charOffset    = static_cast<int>(captures[0].data() - base);
+            int    inputIndex;
+            int    capLength;
+
+            LocateCapture(base, captures[0], isUtf8, startIndex, strStartIndex, inputIndex, capLength, ticks);
+
+            _Match^ rv = gcnew _Match(this, groupCount, input, inputIndex, capLength, charOffset + captures[0].length());
+            rv->_groupmask = groupMask;
+
+            GroupCollection^ groups = rv->Groups;
+            for(int i = 1; i < groupCount; i++)
+            {
+                /* groupCount is at most 64 unless every group is selected. */
+                if(NULL == captures[i] || (groupMask != -1 && !((groupMask >> i) & 1)))
+                    groups[i] = Group::Empty;
+                else
+                {
+                    /*
+                     *  Match tracks the char offset and String index separately in case of UTF-8 String input, but
+                     *  they will be the same if the input is a Byte array, or if the Regex is ASCII or Latin-1.
+                     *
+                     *  There's room here to optimize calculation of the group indices. Currently it jumps back to
+                     *  the beginning of the search for each group, instead of adding incrementally onto the
+                     *  previous group's calculation.
+                     */
+
+                    LocateCapture(base, captures[i], isUtf8, startIndex, strStartIndex, inputIndex, capLength, ticks);
+
+                    groups[i] = gcnew Group(input, inputIndex, capLength);
+                }
+            }
+
+            if(_telemetry)
+                _telemetry->_created(positionTicks, Stopwatch::GetTimestamp() - started - positionTicks);
+
+            return rv;
+        }
+
+
+        _Match^ Regex::_match(RegexInput^ input, int startIndex, int length, int strStartIndex)
+        {
+            return this->_match(input, startIndex, length, strStartIndex, -1);
+        }
+
+
+        _Match^ Regex::_match(RegexInput^ input, int startIndex, int length, int strStartIndex, Int64 groupMask)
+        {
+            /*
+             *  stringStartIndex tracks inputIndex for String inputs between matches to avoid recalculating
+             *  in CharToStrPos(), which is prohibitively costly for large inputs.
+             */
+
+            int          groupCount = this->_groupCount(groupMask);
+            StringPiece* captures   = new StringPiece[groupCount]();
+
+            /*
+             *  Byte arrays are pinned here, for this search only, and not by RegexInput. Captures are
+             *  turned into offsets by _create() before the pin is released.
+             */
+            pin_ptr<Byte> pinned = nullptr;
+            const char*   data   = input->Data;
+            if(input->Bytes)
+            {
+                if(input->Bytes->Length)
+                    pinned = &input->Bytes[0];
+                data = (const char*)pinned + input->Offset;
+            }
+
+            _Match^ rv = _Match::Empty;
+            if(this->_search(data, input->Length, startIndex, startIndex + length, captures, groupCount))
+                rv = this->_create(input, data, captures, groupCount, startIndex, strStartIndex, groupMask);
+
+            /* Likewise for the buffer behind input->Data. */
+            GC::KeepAlive(input);
+
+            delete[] captures;
+
+            return rv;
+        }
+
+
+        _Match^ Regex::_match(String^ input, int startIndex, int length, Int64 groupMask)
+        {
+            int InputSize = input->Length;
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(startIndex < 0 || startIndex > InputSize)
+                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
+            if(length < 0 || length > InputSize)
+                throw gcnew ArgumentOutOfRangeException("length", "Length cannot be less than 0 or greater than input length.");
+            if(startIndex + length - 1 > InputSize)
+                throw gcnew ArgumentOutOfRangeException("startIndex, length", "Start index and length combined cannot be greater than input length.");
+            if(startIndex > 0)
+            {
+                pin_ptr<const wchar_t> chars = PtrToStringChars(input);
+                if((((char*)(&chars[startIndex]))[1] & 0xdc) == 0xdc)
+                    throw gcnew ArgumentException("startIndex", "Start index cannot bisect a UTF-16 surrogate pair.");
+            }
+            
+            /*
+             *  A literal that isn't in the string's own chars isn't worth converting the string for. A lone
+             *  surrogate takes the char after it with it when converted, so then only the bytes can tell.
+             */
+            if(_substring && _substring->HasChars())
+            {
+                pin_ptr<const wchar_t> chars = PtrToStringChars(input);
+                bool found = hasLoneSurrogate(chars, InputSize) || _substring->Find(chars + startIndex, Math::Min(length, InputSize - startIndex)) >= 0;
+                GC::KeepAlive(this);
+                if(!found)
+                    return _Match::Empty;
+            }
+
+            /* If in UTF-8 mode, convert the start and length values from String^ to char* offset. */
+            bool isUtf8 = !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING);
+
+            Int64        started = _telemetry ? Stopwatch::GetTimestamp() : 0;
+            StringPiece* sp      = ConvertStringEncoding(input, "input", this->Options);
+            const char*  data    = sp->data();
+            int          size    = sp->length();
+            delete sp;
+
+            int strStartIndex = startIndex;
+            if(isUtf8)
+            {
+                if(startIndex) startIndex = StrToCharPos(data, startIndex);
+                if(length)     length     = StrToCharPos(data + startIndex, length);
+            }
+
+            if(_telemetry)
+                _telemetry->_converted(Stopwatch::GetTimestamp() - started);
+
+            /*
+             *  The converted input only needs a RegexInput, and the NativeBuffer in it, if there's a Match
+             *  to hold on to it. Otherwise it's freed here and now rather than by the GC.
+             */
+            int          groupCount = this->_groupCount(groupMask);
+            StringPiece* captures   = new StringPiece[groupCount]();
+            _Match^      rv         = _Match::Empty;
+
+            try
+            {
+                if(this->_search(data, size, startIndex, startIndex + length, captures, groupCount))
+                {
+                    RegexInput^ ri = gcnew RegexInput(input, data, size, isUtf8);
+                    data = nullptr;
+                    rv   = this->_create(ri, ri->Data, captures, groupCount, startIndex, strStartIndex, groupMask);
+                }
+            }
+            finally
+            {
+                delete[] captures;
+                free(const_cast<char*>(data));
+            }
+
+            return rv;
+        }
+
+
+        _Match^ Regex::_match(array<Byte>^ input, int startIndex, int length, Int64 groupMask)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(startIndex < 0 || startIndex > input->Length)
+                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
+            if(length < 0 || length > input->Length)
+                throw gcnew ArgumentOutOfRangeException("length", "Length cannot be less than 0 or greater than input length.");
+            if(startIndex + length - 1 > input->Length)
+                throw gcnew ArgumentOutOfRangeException("startIndex, length", "Start index and length combined cannot be greater than input length.");
+
+            /* The array only gets a RegexInput if there's a Match to hold on to it. */
+            int          groupCount = this->_groupCount(groupMask);
+            StringPiece* captures   = new StringPiece[groupCount]();
+            _Match^      rv         = _Match::Empty;
+
+            try
+            {
+                /* Pinned here, not by _search(), until the Match is built. See _search(array<Byte>^). */
+                pin_ptr<Byte> bytes = nullptr;
+                if(input->Length)
+                    bytes = &input[0];
+                const char* data = (const char*)bytes;
+
+                /* Unicode hijinks aren't required for byte arrays. */
+                if(this->_search(data, input->Length, startIndex, startIndex + length, captures, groupCount))
+                {
+                    RegexInput^ ri = gcnew RegexInput(input, !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING));
+                    rv = this->_create(ri, data, captures, groupCount, startIndex, 0, groupMask);
+                }
+            }
+            finally
+            {
+                delete[] captures;
+            }
+
+            return rv;
+        }
+
+
+        _Match^ Regex::Match(String^ input, int startIndex, int length)
+        {
+            return this->_match(input, startIndex, length, -1);
+        }
+
+
+        _Match^ Regex::Match(array<Byte>^ input, int startIndex, int length)
+        {
+            return this->_match(input, startIndex, length, -1);
+        }
+
+
+        _Match^ Regex::Match(String^ input, int startIndex)
+        {
+            return this->Match(input, startIndex, input->Length - startIndex);
+        }
+
+
+        _Match^ Regex::Match(array<Byte>^ input, int startIndex)
+        {
+            return this->Match(input, startIndex, input->Length - startIndex);
+        }
+
+
+        _Match^ Regex::Match(String^ input)
+        {
+            return this->Match(input, 0, input->Length);
+        }
+
+
+        _Match^ Regex::Match(array<Byte>^ input)
+        {
+            return this->Match(input, 0, input->Length);
+        }
+
+
+        _Match^ Regex::MatchGroups(String^ input, int maxGroups)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(maxGroups < 0)
+                throw gcnew ArgumentOutOfRangeException("maxGroups", "Group count cannot be less than 0.");
+
+            return this->_match(input, 0, input->Length, maxGroups >= 63 ? -1 : (1LL << (maxGroups + 1)) - 1);
+        }
+
+
+        _Match^ Regex::MatchGroups(array<Byte>^ input, int maxGroups)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(maxGroups < 0)
+                throw gcnew ArgumentOutOfRangeException("maxGroups", "Group count cannot be less than 0.");
+
+            return this->_match(input, 0, input->Length, maxGroups >= 63 ? -1 : (1LL << (maxGroups + 1)) - 1);
+        }
+
+
+        _Match^ Regex::Match(String^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->Match(input);
+        }
+
+
+        _Match^ Regex::Match(array<Byte>^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->Match(input);
+        }
+
+
+        _Match^ Regex::Match(String^ input, String^ pattern)
+        {
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input);
+        }
+
+
+        _Match^ Regex::Match(array<Byte>^ input, String^ pattern)
+        {
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input);
+        }
+
+        #pragma endregion
+
+
+        #pragma region Matches
+
+        MatchCollection^ Regex::Matches(String^ input, int startIndex)
+        {
+            return gcnew MatchCollection(this->Match(input, startIndex, input->Length - startIndex));
+        }
+
+
+        MatchCollection^ Regex::Matches(array<Byte>^ input, int startIndex)
+        {
+            return gcnew MatchCollection(this->Match(input, startIndex, input->Length - startIndex));
+        }
+
+
+        MatchCollection^ Regex::Matches(String^ input)
+        {
+            return gcnew MatchCollection(this->Match(input, 0, input->Length));
+        }
+
+
+        MatchCollection^ Regex::Matches(array<Byte>^ input)
+        {
+            return gcnew MatchCollection(this->Match(input, 0, input->Length));
+        }
+
+
+        MatchCollection^ Regex::MatchesGroups(String^ input, Int64 groupMask)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            return gcnew MatchCollection(this->_match(input, 0, input->Length, groupMask));
+        }
+
+
+        MatchCollection^ Regex::MatchesGroups(array<Byte>^ input, Int64 groupMask)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            return gcnew MatchCollection(this->_match(input, 0, input->Length, groupMask));
+        }
+
+
+        MatchCollection^ Regex::Matches(String^ input, String^ pattern, RegexOptions options)
+        {
+            return gcnew MatchCollection(Cache::FindOrCreate(pattern, options)->Match(input, 0, input->Length));
+        }
+
+
+        MatchCollection^ Regex::Matches(array<Byte>^ input, String^ pattern, RegexOptions options)
+        {
+            return gcnew MatchCollection(Cache::FindOrCreate(pattern, options)->Match(input, 0, input->Length));
+        }
+
+
+        MatchCollection^ Regex::Matches(String^ input, String^ pattern)
+        {
+            return gcnew MatchCollection(Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input, 0, input->Length));
+        }
+
+
+        MatchCollection^ Regex::Matches(array<Byte>^ input, String^ pattern)
+        {
+            return gcnew MatchCollection(Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input, 0, input->Length));
+        }
+
+        #pragma endregion
+
+
+        #pragma region Typed extraction
+
+        #pragma managed(push, off)
+
+            static RE2::Arg NumberArg(int* value, int radix)
+            {
+                switch(radix)
+                {
+                    case 16: return RE2::Hex(value);
+                    case 8:  return RE2::Octal(value);
+                    case 0:  return RE2::CRadix(value);
+                    default: return RE2::Arg(value);
+                }
+            }
+
+
+            static RE2::Arg NumberArg(long long* value, int radix)
+            {
+                switch(radix)
+                {
+                    case 16: return RE2::Hex(value);
+                    case 8:  return RE2::Octal(value);
+                    case 0:  return RE2::CRadix(value);
+                    default: return RE2::Arg(value);
+                }
+            }
+
+
+            static RE2::Arg NumberArg(double* value, int)
+            {
+                return RE2::Arg(value);
+            }
+
+
+            /*
+             *  An unanchored search that parses groups 1 through count into values, i.e. RE2::PartialMatch()
+             *  with a variable number of arguments. Up to 16 arguments are set up on the stack, which covers
+             *  any realistic record, before falling back on the heap.
+             */
+            template <typename T>
+            static bool ExtractNumbers(const RE2& re2, const char* data, int size, T* values, int count, int radix)
+            {
+                const int       kStackArgs = 16;
+                RE2::Arg        stackArgs[kStackArgs];
+                const RE2::Arg* stackArgv[kStackArgs];
+
+                RE2::Arg*        args = count > kStackArgs ? new RE2::Arg[count] : stackArgs;
+                const RE2::Arg** argv = count > kStackArgs ? new const RE2::Arg*[count] : stackArgv;
+
+                for(int i = 0; i < count; i++)
+                {
+                    args[i] = NumberArg(values + i, radix);
+                    argv[i] = &args[i];
+                }
+
+                bool rv = RE2::PartialMatchN(StringPiece(data, size), re2, argv, count);
+
+                if(args != stackArgs)
+                {
+                    delete[] args;
+                    delete[] argv;
+                }
+
+                return rv;
+            }
+
+        #pragma managed(pop)
+
+
+        template <typename T>
+        bool Regex::_extract(const char* data, int size, array<T>^ values, NumberBase numberBase)
+        {
+            if(numberBase != NumberBase::Decimal && numberBase != NumberBase::Hex && numberBase != NumberBase::Octal && numberBase != NumberBase::CRadix)
+                throw gcnew ArgumentOutOfRangeException("numberBase", "Specified argument was outside the range of valid NumberBase values.");
+            if(values->Length > _re2->NumberOfCapturingGroups())
+                throw gcnew ArgumentException("The array has more elements than the regular expression has capturing groups.", "values");
+
+            /* RE2 parses straight into the array. */
+            pin_ptr<T> pinned = nullptr;
+            if(values->Length)
+                pinned = &values[0];
+
+            /* ExtractNumbers searches without _search(), so it's timed here. */
+            Int64 started = _telemetry ? Stopwatch::GetTimestamp() : 0;
+            bool  rv      = ExtractNumbers(*this->_engine(), data, size, (T*)pinned, values->Length, static_cast<int>(numberBase));
+
+            if(_telemetry)
+                _telemetry->_searched(size, rv, Stopwatch::GetTimestamp() - started);
+
+            /* See _search(). */
+            GC::KeepAlive(this);
+
+            return rv;
+        }
+
+
+        template <typename T>
+        bool Regex::_extract(String^ input, array<T>^ values, NumberBase numberBase)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(!values)
+                throw gcnew ArgumentNullException("values", "Value cannot be null.");
+
+            Int64        started = _telemetry ? Stopwatch::GetTimestamp() : 0;
+            StringPiece* sp      = ConvertStringEncoding(input, "input", this->Options);
+
+            if(_telemetry)
+                _telemetry->_converted(Stopwatch::GetTimestamp() - started);
+
+            try
+            {
+                return this->_extract(sp->data(), sp->length(), values, numberBase);
+            }
+            finally
+            {
+                free(const_cast<char*>(sp->data()));
+                delete sp;
+            }
+        }
+
+
+        template <typename T>
+        bool Regex::_extract(array<Byte>^ input, array<T>^ values, NumberBase numberBase)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(!values)
+                throw gcnew ArgumentNullException("values", "Value cannot be null.");
+
+            /* ExtractNumbers doesn't run through _search(), but pins the same way. See _search(array<Byte>^). */
+            pin_ptr<Byte> bytes = nullptr;
+            if(input->Length)
+                bytes = &input[0];
+
+            return this->_extract((const char*)bytes, input->Length, values, numberBase);
+        }
+
+
+
+        bool Regex::TryExtract(String^ input, array<Int32>^ values)
+        {
+            return this->_extract(input, values, NumberBase::Decimal);
+        }
+
+
+        bool Regex::TryExtract(array<Byte>^ input, array<Int32>^ values)
+        {
+            return this->_extract(input, values, NumberBase::Decimal);
+        }
+
+
+        bool Regex::TryExtract(String^ input, array<Int32>^ values, NumberBase numberBase)
+        {
+            return this->_extract(input, values, numberBase);
+        }
+
+
+        bool Regex::TryExtract(array<Byte>^ input, array<Int32>^ values, NumberBase numberBase)
+        {
+            return this->_extract(input, values, numberBase);
+        }
+
+
+        bool Regex::TryExtract(String^ input, array<Int64>^ values)
+        {
+            return this->_extract(input, values, NumberBase::Decimal);
+        }
+
+
+        bool Regex::TryExtract(array<Byte>^ input, array<Int64>^ values)
+        {
+            return this->_extract(input, values, NumberBase::Decimal);
+        }
+
+
+        bool Regex::TryExtract(String^ input, array<Int64>^ values, NumberBase numberBase)
+        {
+            return this->_extract(input, values, numberBase);
+        }
+
+
+        bool Regex::TryExtract(array<Byte>^ input, array<Int64>^ values, NumberBase numberBase)
+        {
+            return this->_extract(input, values, numberBase);
+        }
+
+
+        bool Regex::TryExtract(String^ input, array<Double>^ values)
+        {
+            return this->_extract(input, values, NumberBase::Decimal);
+        }
+
+
+        bool Regex::TryExtract(array<Byte>^ input, array<Double>^ values)
+        {
+            return this->_extract(input, values, NumberBase::Decimal);
+        }
+
+        #pragma endregion
+
+
+        #pragma region Sorted key ranges
+
+        #pragma managed(push, off)
+
+            /*
+             *  Compares a UTF-16 key with a bound from RE2::PossibleMatchRange() as if the key had been
+             *  converted to the bound's encoding, but without converting it. A char beyond Latin-1 sorts
+             *  after any single-byte bound, as it would in an ordinal comparison.
+             */
+            static int CompareSortedKey(const wchar_t* chars, int length, const string& bound, bool isUtf8)
+            {
+                const unsigned char* b    = reinterpret_cast<const unsigned char*>(bound.data());
+                int                  size = static_cast<int>(bound.size());
+                int                  pos  = 0;
+                unsigned char        utf8[4];
+
+                for(int i = 0; i < length; ++i)
+                {
+                    int c = chars[i];
+                    int n = 1;
+
+                    if(!isUtf8)
+                    {
+                        if(c > 0xff)
+                            return 1;
+                        utf8[0] = static_cast<unsigned char>(c);
+                    }
+                    else
+                    {
+                        /* A lone surrogate is compared as its own code point. */
+                        if(c >= 0xd800 && c <= 0xdbff && i + 1 < length && chars[i + 1] >= 0xdc00 && chars[i + 1] <= 0xdfff)
+                            c = (c - 0xd800) * 0x400 + (chars[++i] - 0xdc00) + 0x10000;
+
+                        if(c < 0x80)
+                        {
+                            utf8[0] = static_cast<unsigned char>(c);
+                        }
+                        else if(c < 0x800)
+                        {
+                            utf8[0] = static_cast<unsigned char>(0xc0 | (c >> 6));
+                            utf8[1] = static_cast<unsigned char>(0x80 | (c & 0x3f));
+                            n = 2;
+                        }
+                        else if(c < 0x10000)
+                        {
+                            utf8[0] = static_cast<unsigned char>(0xe0 | (c >> 12));
+                            utf8[1] = static_cast<unsigned char>(0x80 | ((c >> 6) & 0x3f));
+                            utf8[2] = static_cast<unsigned char>(0x80 | (c & 0x3f));
+                            n = 3;
+                        }
+                        else
+                        {
+                            utf8[0] = static_cast<unsigned char>(0xf0 | (c >> 18));
+                            utf8[1] = static_cast<unsigned char>(0x80 | ((c >> 12) & 0x3f));
+                            utf8[2] = static_cast<unsigned char>(0x80 | ((c >> 6) & 0x3f));
+                            utf8[3] = static_cast<unsigned char>(0x80 | (c & 0x3f));
+                            n = 4;
+                        }
+                    }
+
+                    for(int k = 0; k < n; ++k, ++pos)
+                    {
+                        if(pos == size)
+                            return 1;
+                        if(utf8[k] != b[pos])
+                            return utf8[k] < b[pos] ? -1 : 1;
+                    }
+                }
+
+                return pos < size ? -1 : 0;
+            }
+
+
+            static int CompareSortedKey(const unsigned char* key, int length, const string& bound)
+            {
+                int size = static_cast<int>(bound.size());
+                int n    = length < size ? length : size;
+                int rv   = n ? memcmp(key, bound.data(), n) : 0;
+
+                if(rv)
+                    return rv;
+                return length < size ? -1 : length > size ? 1 : 0;
+            }
+
+        #pragma managed(pop)
+
+
+        /*
+         *  Binary search for the first key not less than bound or, if pastEqual is set, the first key
+         *  greater than it.
+         */
+        static int SearchSortedKeys(IList<String^>^ keys, int lo, int hi, const string& bound, bool isUtf8, bool pastEqual)
+        {
+            while(lo < hi)
+            {
+                int     mid = lo + (hi - lo) / 2;
+                String^ key = keys[mid];
+                if(!key)
+                    throw gcnew ArgumentNullException("sortedKeys", "The list contains a null element.");
+
+                pin_ptr<const wchar_t> chars = PtrToStringChars(key);
+                int                    c     = CompareSortedKey(chars, key->Length, bound, isUtf8);
+
+                if(c < 0 || (pastEqual && !c))
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo;
+        }
+
+
+        static int SearchSortedKeys(IList<array<Byte>^>^ keys, int lo, int hi, const string& bound, bool pastEqual)
+        {
+            while(lo < hi)
+            {
+                int          mid = lo + (hi - lo) / 2;
+                array<Byte>^ key = keys[mid];
+                if(!key)
+                    throw gcnew ArgumentNullException("sortedKeys", "The list contains a null element.");
+
+                pin_ptr<Byte> bytes = nullptr;
+                if(key->Length)
+                    bytes = &key[0];
+                int c = CompareSortedKey(bytes, key->Length, bound);
+
+                if(c < 0 || (pastEqual && !c))
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo;
+        }
+
+
+        static array<Byte>^ StdStringToBytes(const string& str)
+        {
+            array<Byte>^ bytes = gcnew array<Byte>(static_cast<int>(str.size()));
+            if(bytes->Length)
+                Marshal::Copy((IntPtr)const_cast<char*>(str.data()), bytes, 0, bytes->Length);
+            return bytes;
+        }
+
+
+        bool Regex::PossibleMatchRange(int maxLength, array<Byte>^% min, array<Byte>^% max)
+        {
+            if(maxLength < 0)
+                throw gcnew ArgumentOutOfRangeException("maxLength", "Maximum length cannot be less than 0.");
+
+            string pmin;
+            string pmax;
+            bool   rv = _re2->PossibleMatchRange(&pmin, &pmax, maxLength);
+
+            /* See _search(). */
+            GC::KeepAlive(this);
+
+            min = StdStringToBytes(pmin);
+            max = StdStringToBytes(pmax);
+            return rv;
+        }
+
+
+        array<int>^ Regex::FullMatchSorted(IList<String^>^ sortedKeys)
+        {
+            if(!sortedKeys)
+                throw gcnew ArgumentNullException("sortedKeys", "Value cannot be null.");
+
+            RegexOptions options = this->Options;
+            bool         isUtf8  = !RegexOption::HasAnyFlag(options, SINGLE_BYTE_ENCODING);
+            int          first   = 0;
+            int          last    = sortedKeys->Count;
+            string       min;
+            string       max;
+
+            /* An empty upper bound is unbounded: RE2 rounded up a bound of nothing but 0xff bytes. */
+            if(_re2->PossibleMatchRange(&min, &max, SORTED_RANGE_LENGTH))
+            {
+                first = SearchSortedKeys(sortedKeys, first, last, min, isUtf8, false);
+                if(!max.empty())
+                    last = SearchSortedKeys(sortedKeys, first, last, max, isUtf8, true);
+            }
+
+            /* See _search(). */
+            GC::KeepAlive(this);
+
+            List<int>^       rv      = gcnew List<int>();
+            ConversionBuffer scratch;
+
+            for(int i = first; i < last; i++)
+            {
+                String^ key = sortedKeys[i];
+                if(!key)
+                    throw gcnew ArgumentNullException("sortedKeys", "The list contains a null element.");
+
+                Int64 started = _telemetry ? Stopwatch::GetTimestamp() : 0;
+                int   size    = ConvertStringEncoding(key, "sortedKeys", options, &scratch);
+
+                if(_telemetry)
+                    _telemetry->_converted(Stopwatch::GetTimestamp() - started);
+
+                if(this->_search(scratch.data, size, 0, size, NULL, 0, RE2::ANCHOR_BOTH))
+                    rv->Add(i);
+            }
+
+            return rv->ToArray();
+        }
+
+
+        array<int>^ Regex::FullMatchSorted(IList<array<Byte>^>^ sortedKeys)
+        {
+            if(!sortedKeys)
+                throw gcnew ArgumentNullException("sortedKeys", "Value cannot be null.");
+
+            int    first = 0;
+            int    last  = sortedKeys->Count;
+            string min;
+            string max;
+
+            if(_re2->PossibleMatchRange(&min, &max, SORTED_RANGE_LENGTH))
+            {
+                first = SearchSortedKeys(sortedKeys, first, last, min, false);
+                if(!max.empty())
+                    last = SearchSortedKeys(sortedKeys, first, last, max, true);
+            }
+
+            /* See _search(). */
+            GC::KeepAlive(this);
+
+            List<int>^ rv = gcnew List<int>();
+
+            for(int i = first; i < last; i++)
+            {
+                array<Byte>^ key = sortedKeys[i];
+                if(!key)
+                    throw gcnew ArgumentNullException("sortedKeys", "The list contains a null element.");
+
+                if(this->_search(key, 0, key->Length, NULL, 0, RE2::ANCHOR_BOTH))
+                    rv->Add(i);
+            }
+
+            return rv->ToArray();
+        }
+
+        #pragma endregion
+
+
+        #pragma region Unmanaged and segmented input
+
+        static void ValidateUnmanagedInput(IntPtr data, Int64 length)
+        {
+            if(length < 0 || length > Int32::MaxValue)
+                throw gcnew ArgumentOutOfRangeException("length", "Length cannot be less than 0 or greater than Int32.MaxValue.");
+            if(data == IntPtr::Zero && length > 0)
+                throw gcnew ArgumentNullException("data", "Value cannot be null.");
+        }
+
+
+        bool Regex::IsMatch(IntPtr data, Int64 length)
+        {
+            ValidateUnmanagedInput(data, length);
+
+            int size = static_cast<int>(length);
+            return this->_search((const char*)data.ToPointer(), size, 0, size, NULL, 0);
+        }
+
+
+        bool Regex::IsMatch(ArraySegment<Byte> input)
+        {
+            if(!input.Array)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            /* An empty segment can still match an empty pattern, but it might not be pinnable. */
+            if(!input.Count)
+                return this->_search(nullptr, 0, 0, 0, NULL, 0);
+
+            pin_ptr<Byte> bytes = &input.Array[input.Offset];
+            return this->_search((const char*)bytes, input.Count, 0, input.Count, NULL, 0);
+        }
+
+
+        _Match^ Regex::Match(IntPtr data, Int64 length)
+        {
+            ValidateUnmanagedInput(data, length);
+
+            RegexInput^ ri = gcnew RegexInput(data, static_cast<int>(length), !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING));
+            return this->_match(ri, 0, ri->Length, 0);
+        }
+
+
+        _Match^ Regex::Match(ArraySegment<Byte> input)
+        {
+            if(!input.Array)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            RegexInput^ ri = gcnew RegexInput(input.Array, input.Offset, input.Count, !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING));
+            return this->_match(ri, 0, ri->Length, 0);
+        }
+
+
+        MatchCollection^ Regex::Matches(IntPtr data, Int64 length)
+        {
+            return gcnew MatchCollection(this->Match(data, length));
+        }
+
+
+        MatchCollection^ Regex::Matches(ArraySegment<Byte> input)
+        {
+            return gcnew MatchCollection(this->Match(input));
+        }
+
+        #pragma endregion
+
+
+        #pragma region Batch matching
+
+        Regex::Batch::Batch(Regex^ regex, IList<String^>^ strings, IList<array<Byte>^>^ bytes, array<bool>^ isMatch, array<_Match^>^ matches)
+            : _regex(regex), _strings(strings), _bytes(bytes), _isMatch(isMatch), _matches(matches)
+        { }
+
+
+        void Regex::Batch::Run(int count, int maxDegreeOfParallelism)
+        {
+            if(!count)
+                return;
+
+            /*
+             *  Ranges are kept small enough that every worker gets several of them, so that
+             *  idle workers have something to take from busy ones, but large enough that the
+             *  per-range overhead of the loop is lost in the matching.
+             */
+            int rangeSize = Math::Max(64, count / (Environment::ProcessorCount * 8));
+
+            ParallelOptions^ options = gcnew ParallelOptions();
+            options->MaxDegreeOfParallelism = maxDegreeOfParallelism;
+
+            Parallel::ForEach<Tuple<int, int>^, IntPtr>(
+                Partitioner::Create(0, count, rangeSize),
+                options,
+                gcnew Func<IntPtr>(this, &Batch::Init),
+                gcnew Func<Tuple<int, int>^, ParallelLoopState^, IntPtr, IntPtr>(this, &Batch::Body),
+                gcnew Action<IntPtr>(this, &Batch::Finally));
+        }
+
+
+        IntPtr Regex::Batch::Init()
+        {
+            return IntPtr(new ConversionBuffer());
+        }
+
+
+        void Regex::Batch::Finally(IntPtr buffer)
+        {
+            delete static_cast<ConversionBuffer*>(buffer.ToPointer());
+        }
+
+
+        IntPtr Regex::Batch::Body(Tuple<int, int>^ range, ParallelLoopState^ state, IntPtr buffer)
+        {
+            ConversionBuffer* scratch    = static_cast<ConversionBuffer*>(buffer.ToPointer());
+            RegexOptions      options    = _regex->Options;
+            bool              isUtf8     = !RegexOption::HasAnyFlag(options, SINGLE_BYTE_ENCODING);
+            int               groupCount = _isMatch ? 0 : _regex->_groupCount();
+            StringPiece*      captures   = groupCount ? new StringPiece[groupCount]() : nullptr;
+
+            try
+            {
+                for(int i = range->Item1; i < range->Item2; i++)
+                {
+                    if(_strings)
+                    {
+                        String^ input = _strings[i];
+                        if(!input)
+                            throw gcnew ArgumentNullException("inputs", "The list contains a null element.");
+
+                        Int64 started = _regex->_telemetry ? Stopwatch::GetTimestamp() : 0;
+                        int   size    = ConvertStringEncoding(input, "inputs", options, scratch);
+
+                        if(_regex->_telemetry)
+                            _regex->_telemetry->_converted(Stopwatch::GetTimestamp() - started);
+
+                        if(_isMatch)
+                            _isMatch[i] = _regex->_search(scratch->data, size, 0, size, nullptr, 0);
+                        else if(!_regex->_search(scratch->data, size, 0, size, captures, groupCount))
+                            _matches[i] = _Match::Empty;
+                        else
+                        {
+                            /* The scratch buffer is reused, so the Match needs a copy it can own. */
+                            char* copy = static_cast<char*>(malloc(size));
+                            if(!copy && size)
+                                throw gcnew OutOfMemoryException();
+                            memcpy(copy, scratch->data, size);
+
+                            RegexInput^ ri = gcnew RegexInput(input, copy, size, isUtf8);
+                            _matches[i] = _regex->_create(ri, scratch->data, captures, groupCount, 0, 0);
+                        }
+                    }
+                    else
+                    {
+                        array<Byte>^ input = _bytes[i];
+                        if(!input)
+                            throw gcnew ArgumentNullException("inputs", "The list contains a null element.");
+
+                        if(_isMatch)
+                        {
+                            _isMatch[i] = _regex->_search(input, 0, input->Length, nullptr, 0, RE2::UNANCHORED);
+                            continue;
+                        }
+
+                        /* Pinned here, not by _search(), until the Match is built. See _search(array<Byte>^). */
+                        pin_ptr<Byte> bytes = nullptr;
+                        if(input->Length)
+                            bytes = &input[0];
+                        const char* data = (const char*)bytes;
+
+                        if(!_regex->_search(data, input->Length, 0, input->Length, captures, groupCount))
+                            _matches[i] = _Match::Empty;
+                        else
+                        {
+                            RegexInput^ ri = gcnew RegexInput(input, isUtf8);
+                            _matches[i] = _regex->_create(ri, data, captures, groupCount, 0, 0);
+                        }
+                    }
+                }
+            }
+            finally
+            {
+                delete[] captures;
+            }
+
+            return buffer;
+        }
+
+
+        array<bool>^ Regex::IsMatchBatch(IList<String^>^ inputs, int maxDegreeOfParallelism)
+        {
+            if(!inputs)
+                throw gcnew ArgumentNullException("inputs", "Value cannot be null.");
+            if(maxDegreeOfParallelism == 0 || maxDegreeOfParallelism < -1)
+                throw gcnew ArgumentOutOfRangeException("maxDegreeOfParallelism", "Degree of parallelism must be -1 or greater than 0.");
+
+            array<bool>^ rv = gcnew array<bool>(inputs->Count);
+            (gcnew Batch(this, inputs, nullptr, rv, nullptr))->Run(inputs->Count, maxDegreeOfParallelism);
+            return rv;
+        }
+
+
+        array<bool>^ Regex::IsMatchBatch(IList<array<Byte>^>^ inputs, int maxDegreeOfParallelism)
+        {
+            if(!inputs)
+                throw gcnew ArgumentNullException("inputs", "Value cannot be null.");
+            if(maxDegreeOfParallelism == 0 || maxDegreeOfParallelism < -1)
+                throw gcnew ArgumentOutOfRangeException("maxDegreeOfParallelism", "Degree of parallelism must be -1 or greater than 0.");
+
+            array<bool>^ rv = gcnew array<bool>(inputs->Count);
+            (gcnew Batch(this, nullptr, inputs, rv, nullptr))->Run(inputs->Count, maxDegreeOfParallelism);
+            return rv;
+        }
+
+
+        array<bool>^ Regex::IsMatchBatch(IList<String^>^ inputs)
+        {
+            return this->IsMatchBatch(inputs, -1);
+        }
+
+
+        array<bool>^ Regex::IsMatchBatch(IList<array<Byte>^>^ inputs)
+        {
+            return this->IsMatchBatch(inputs, -1);
+        }
+
+
+        array<_Match^>^ Regex::MatchBatch(IList<String^>^ inputs, int maxDegreeOfParallelism)
+        {
+            if(!inputs)
+                throw gcnew ArgumentNullException("inputs", "Value cannot be null.");
+            if(maxDegreeOfParallelism == 0 || maxDegreeOfParallelism < -1)
+                throw gcnew ArgumentOutOfRangeException("maxDegreeOfParallelism", "Degree of parallelism must be -1 or greater than 0.");
+
+            array<_Match^>^ rv = gcnew array<_Match^>(inputs->Count);
+            (gcnew Batch(this, inputs, nullptr, nullptr, rv))->Run(inputs->Count, maxDegreeOfParallelism);
+            return rv;
+        }
+
+
+        array<_Match^>^ Regex::MatchBatch(IList<array<Byte>^>^ inputs, int maxDegreeOfParallelism)
+        {
+            if(!inputs)
+                throw gcnew ArgumentNullException("inputs", "Value cannot be null.");
+            if(maxDegreeOfParallelism == 0 || maxDegreeOfParallelism < -1)
+                throw gcnew ArgumentOutOfRangeException("maxDegreeOfParallelism", "Degree of parallelism must be -1 or greater than 0.");
+
+            array<_Match^>^ rv = gcnew array<_Match^>(inputs->Count);
+            (gcnew Batch(this, nullptr, inputs, nullptr, rv))->Run(inputs->Count, maxDegreeOfParallelism);
+            return rv;
+        }
+
+
+        array<_Match^>^ Regex::MatchBatch(IList<String^>^ inputs)
+        {
+            return this->MatchBatch(inputs, -1);
+        }
+
+
+        array<_Match^>^ Regex::MatchBatch(IList<array<Byte>^>^ inputs)
+        {
+            return this->MatchBatch(inputs, -1);
+        }
+
+        #pragma endregion
+
+    #pragma endregion
+
+
+    #pragma region Background compilation and warm-up
+
+        Regex::Compilation::Compilation(String^ pattern, RegexOptions options, IEnumerable<String^>^ sampleInputs)
+            : _pattern(pattern), _options(options), _sampleInputs(sampleInputs)
+        { }
+
+
+        Regex^ Regex::Compilation::Run()
+        {
+            Regex^ regex = gcnew Regex(_pattern, _options);
+            if(_sampleInputs)
+                regex->WarmUp(_sampleInputs);
+            return regex;
+        }
+
+
+        Task<Regex^>^ Regex::CompileAsync(String^ pattern)
+        {
+            return Regex::CompileAsync(pattern, RegexOptions::None);
+        }
+
+
+        Task<Regex^>^ Regex::CompileAsync(String^ pattern, RegexOptions options)
+        {
+            if(!pattern)
+                throw gcnew ArgumentNullException("pattern", "Value cannot be null.");
+
+            Compilation^ compilation = gcnew Compilation(pattern, options, nullptr);
+            return Task::Run<Regex^>(gcnew Func<Regex^>(compilation, &Compilation::Run));
+        }
+
+
+        Task<Regex^>^ Regex::CompileAsync(String^ pattern, RegexOptions options, IEnumerable<String^>^ sampleInputs)
+        {
+            if(!pattern)
+                throw gcnew ArgumentNullException("pattern", "Value cannot be null.");
+            if(!sampleInputs)
+                throw gcnew ArgumentNullException("sampleInputs", "Value cannot be null.");
+
+            Compilation^ compilation = gcnew Compilation(pattern, options, sampleInputs);
+            return Task::Run<Regex^>(gcnew Func<Regex^>(compilation, &Compilation::Run));
+        }
+
+
+        void Regex::_warmUp(const char* data, int size)
+        {
+            /*
+             *  This goes straight to RE2, since the literal and bit-parallel strategies would skip it
+             *  for the very inputs they decide themselves, but not for the ones they hand back.
+             */
+            const RE2*   engine     = this->_engine();
+            int          groupCount = 1 + _re2->NumberOfCapturingGroups();
+            StringPiece* captures   = new StringPiece[groupCount]();
+
+            try
+            {
+                StringPiece text(data, size);
+                engine->Match(text, 0, size, RE2::UNANCHORED, nullptr, 0);
+                engine->Match(text, 0, size, RE2::UNANCHORED, captures, groupCount);
+                engine->Match(text, 0, size, RE2::ANCHOR_BOTH, nullptr, 0);
+            }
+            finally
+            {
+                delete[] captures;
+            }
+
+            GC::KeepAlive(this);
+        }
+
+
+        void Regex::WarmUp(IEnumerable<String^>^ sampleInputs)
+        {
+            if(!sampleInputs)
+                throw gcnew ArgumentNullException("sampleInputs", "Value cannot be null.");
+
+            ConversionBuffer buffer;
+            for each(String^ input in sampleInputs)
+            {
+                if(!input)
+                    throw gcnew ArgumentNullException("sampleInputs", "Sample inputs cannot be null.");
+
+                Int64 started = _telemetry ? Stopwatch::GetTimestamp() : 0;
+                int   size    = ConvertStringEncoding(input, "sampleInputs", this->Options, &buffer);
+
+                if(_telemetry)
+                    _telemetry->_converted(Stopwatch::GetTimestamp() - started);
+
+                this->_warmUp(buffer.data, size);
+                this->Match(input);
+            }
         }
 
 
-        bool Regex::IsMatch(array<Byte>^ input, int startIndex)
+        void Regex::WarmUp(IEnumerable<array<Byte>^>^ sampleInputs)
         {
-            if(!input)
-                throw gcnew ArgumentNullException("input", "Value cannot be null.");
-            if(startIndex < 0 || startIndex > input->Length)
-                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
+            if(!sampleInputs)
+                throw gcnew ArgumentNullException("sampleInputs", "Value cannot be null.");
 
-            pin_ptr<unsigned char> bytes = &input[0];
-            StringPiece* sp = new StringPiece((const char*)bytes, input->Length);
-            bool         rv = _re2->Match(*sp, startIndex, sp->length(), RE2::UNANCHORED, NULL, 0);
-            
-            delete sp;
-            
-            return rv;
-        }
+            for each(array<Byte>^ input in sampleInputs)
+            {
+                if(!input)
+                    throw gcnew ArgumentNullException("sampleInputs", "Sample inputs cannot be null.");
 
+                /* See _search(array<Byte>^). */
+                pin_ptr<Byte> bytes = nullptr;
+                if(input->Length)
+                    bytes = &input[0];
 
-        bool Regex::IsMatch(String^ input)
-        {
-            return this->IsMatch(input, 0);
+                this->_warmUp((const char*)bytes, input->Length);
+                this->Match(input);
+            }
         }
 
+    #pragma endregion
+
 
-        bool Regex::IsMatch(array<Byte>^ input)
+    #pragma region Bulk compilation
+
+        Regex::BulkCompilation::BulkCompilation(IList<Tuple<String^, RegexOptions, int>^>^ definitions, array<Regex^>^ regexes, array<String^>^ errors)
+            : _definitions(definitions), _regexes(regexes), _errors(errors)
+        { }
+
+
+        void Regex::BulkCompilation::Run(int maxDegreeOfParallelism)
         {
-            return this->IsMatch(input, 0);
+            if(!_definitions->Count)
+                return;
+
+            /*
+             *  Compile times range from microseconds for a literal to milliseconds for a large
+             *  counted repetition, so ranges are kept small for idle workers to take them from
+             *  busy ones.
+             */
+            int rangeSize = Math::Max(1, _definitions->Count / (Environment::ProcessorCount * 16));
+
+            ParallelOptions^ options = gcnew ParallelOptions();
+            options->MaxDegreeOfParallelism = maxDegreeOfParallelism;
+
+            Parallel::ForEach<Tuple<int, int>^>(
+                Partitioner::Create(0, _definitions->Count, rangeSize),
+                options,
+                gcnew Action<Tuple<int, int>^>(this, &BulkCompilation::Body));
         }
 
 
-        bool Regex::IsMatch(String^ input, String^ pattern, RegexOptions options)
+        void Regex::BulkCompilation::Body(Tuple<int, int>^ range)
         {
-            return Cache::FindOrCreate(pattern, options)->IsMatch(input);
+            for(int i = range->Item1; i < range->Item2; i++)
+            {
+                Tuple<String^, RegexOptions, int>^ definition = _definitions[i];
+
+                /* Every error the constructor reports about its arguments is an ArgumentException. */
+                try
+                {
+                    _regexes[i] = gcnew Regex(definition->Item1, definition->Item2, definition->Item3);
+                }
+                catch(ArgumentException^ ex)
+                {
+                    _errors[i] = ex->Message;
+                }
+            }
         }
 
 
-        bool Regex::IsMatch(array<Byte>^ input, String^ pattern, RegexOptions options)
+        array<Regex^>^ Regex::CompileAll(IEnumerable<Tuple<String^, RegexOptions, int>^>^ definitions, array<String^>^% errors, bool addToCache, int maxDegreeOfParallelism)
         {
-            return Cache::FindOrCreate(pattern, options)->IsMatch(input);
+            if(!definitions)
+                throw gcnew ArgumentNullException("definitions", "Value cannot be null.");
+            if(maxDegreeOfParallelism == 0 || maxDegreeOfParallelism < -1)
+                throw gcnew ArgumentOutOfRangeException("maxDegreeOfParallelism", "Degree of parallelism must be -1 or greater than 0.");
+
+            /* Copied, so that the loop can index it and the caller's collection is enumerated only once. */
+            List<Tuple<String^, RegexOptions, int>^>^ list = gcnew List<Tuple<String^, RegexOptions, int>^>(definitions);
+            for each(Tuple<String^, RegexOptions, int>^ definition in list)
+                if(!definition)
+                    throw gcnew ArgumentNullException("definitions", "The list contains a null element.");
+
+            array<Regex^>^  regexes = gcnew array<Regex^>(list->Count);
+            array<String^>^ failed  = gcnew array<String^>(list->Count);
+            (gcnew BulkCompilation(list, regexes, failed))->Run(maxDegreeOfParallelism);
+
+            /* In order, so that the last definitions are the ones left in a cache too small for all of them. */
+            if(addToCache)
+                for each(Regex^ regex in regexes)
+                    if(regex)
+                        Cache::Add(regex);
+
+            errors = failed;
+            return regexes;
         }
 
 
-        bool Regex::IsMatch(String^ input, String^ pattern)
+        array<Regex^>^ Regex::CompileAll(IEnumerable<Tuple<String^, RegexOptions, int>^>^ definitions, array<String^>^% errors, bool addToCache)
         {
-            return Cache::FindOrCreate(pattern, RegexOptions::None)->IsMatch(input);
+            return Regex::CompileAll(definitions, errors, addToCache, -1);
         }
 
 
-        bool Regex::IsMatch(array<Byte>^ input, String^ pattern)
+        array<Regex^>^ Regex::CompileAll(IEnumerable<Tuple<String^, RegexOptions, int>^>^ definitions, array<String^>^% errors)
         {
-            return Cache::FindOrCreate(pattern, RegexOptions::None)->IsMatch(input);
+            return Regex::CompileAll(definitions, errors, false, -1);
         }
 
-        #pragma endregion
+    #pragma endregion
 
 
-        #pragma region Match
+    #pragma region Regex constructors and cleanup
 
-        _Match^ Regex::_match(RegexInput^ input, int startIndex, int length, int strStartIndex)
+        /*
+         *  Returns a LiteralSearch if the pattern is an alternation of 2 to LiteralSearch::MAX_LITERALS
+         *  plain literals, optionally wrapped in one group, e.g. "Tom|Sawyer" or "(?:Tom|Sawyer)", and
+         *  the options don't change what the literals match. Otherwise returns nullptr.
+         */
+        static LiteralSearch* CreateLiteralSearch(String^ pattern, RegexOptions options)
         {
-            /*
-             *  stringStartIndex tracks inputIndex for String inputs between matches to avoid recalculating
-             *  in CharToStrPos(), which is prohibitively costly for large inputs.
-             */
+            if(RegexOption::HasAnyFlag(options, RegexOptions::IgnoreCase | RegexOptions::Literal))
+                return nullptr;
 
-            int          groupCount = RegexOption::HasAnyFlag(this->Options, RegexOptions::SingleCapture) ? 1 : 1 + _re2->NumberOfCapturingGroups();
-            StringPiece* captures   = new StringPiece[groupCount]();
-            StringPiece  haystack(input->Data, input->Length);
+            /* A group can't contain another, so if the stripped body has no parentheses, they matched. */
+            String^ body = pattern;
+            if(body->StartsWith("(?:") && body->EndsWith(")"))
+                body = body->Substring(3, body->Length - 4);
+            else if(body->StartsWith("(") && !body->StartsWith("(?") && body->EndsWith(")"))
+                body = body->Substring(1, body->Length - 2);
 
-            _Match^ rv = _Match::Empty;
-            if(_re2->Match(haystack, startIndex, startIndex + length, RE2::UNANCHORED, captures, groupCount))
-            {
-                /* Ignore the encoding of input byte arrays. */
-                bool isUtf8     = input->Bytes ? false : input->IsUTF8;
-                int  charOffset = static_cast<int>(captures[0].data() - haystack.data());
-                int  inputIndex = isUtf8 && charOffset ? CharToStrPos(haystack.data() + startIndex, charOffset - startIndex) + strStartIndex : charOffset;
-                int  capLength  = isUtf8 ? CharToStrPos(captures[0].data(), captures[0].length()) : captures[0].length();
+            List<String^>^ literals = gcnew List<String^>();
+            StringBuilder^ literal  = gcnew StringBuilder();
 
-                rv = gcnew _Match(this, groupCount, input, inputIndex, capLength, charOffset + captures[0].length());
+            for(int i = 0; i <= body->Length; i++)
+            {
+                if(i == body->Length || body[i] == '|')
+                {
+                    if(!literal->Length || literals->Count == LiteralSearch::MAX_LITERALS)
+                        return nullptr;
+                    literals->Add(literal->ToString());
+                    literal->Clear();
+                    continue;
+                }
 
-                GroupCollection^ groups = rv->Groups;
-                for(int i = 1; i < groupCount; i++)
+                wchar_t c = body[i];
+                if(c == '\\')
                 {
-                    if(NULL == captures[i])
-                        groups[i] = Group::Empty;
-                    else
-                    {
-                        /*
-                         *  Match tracks the char offset and String index separately in case of UTF-8 String input, but
-                         *  they will be the same if the input is a Byte array, or if the Regex is ASCII or Latin-1.
-                         *
-                         *  There's room here to optimize calculation of the group indices. Currently it jumps back to
-                         *  the beginning of the search for each group, instead of adding incrementally onto the
-                         *  previous group's calculation.
-                         */
-
-                        charOffset = static_cast<int>(captures[i].data() - haystack.data());
-                        inputIndex = isUtf8 && charOffset ? CharToStrPos(haystack.data() + startIndex, charOffset - startIndex) + strStartIndex : charOffset;
-                        capLength  = isUtf8 ? CharToStrPos(captures[i].data(), captures[i].length()) : captures[i].length();
-
-                        groups[i] = gcnew Group(input, inputIndex, capLength);
-                    }
+                    /* Only escaped punctuation is a literal; \d, \x41, \Q, etc. are left to RE2. */
+                    if(++i == body->Length)
+                        return nullptr;
+                    c = body[i];
+                    if(c >= 0x80 || Char::IsLetterOrDigit(c))
+                        return nullptr;
                 }
+                else if(!c || wcschr(L"()[]{}.*+?^$\n", c))
+                    return nullptr;
+
+                literal->Append(c);
             }
 
-            delete[] captures;
+            if(literals->Count < 2)
+                return nullptr;
 
-            return rv;
+            std::vector<string> bytes;
+            for each(String^ s in literals)
+            {
+                StringPiece* sp = ConvertStringEncoding(s, "pattern", options);
+                bytes.push_back(string(sp->data(), sp->length()));
+                free(const_cast<char*>(sp->data()));
+                delete sp;
+            }
+
+            return new LiteralSearch(bytes);
         }
 
 
-        _Match^ Regex::Match(String^ input, int startIndex, int length)
+        /*
+         *  Returns a SubstringSearch if RegexOptions::Literal is set and the options don't make RE2 match
+         *  anything the literal itself wouldn't. Otherwise returns nullptr.
+         *
+         *  With IgnoreCase, the literal must be ASCII, whose letters fold only to each other, except in
+         *  UTF-8 mode, where 'k' also folds to the Kelvin sign and 's' to the long s.
+         */
+        static SubstringSearch* CreateSubstringSearch(String^ pattern, RegexOptions options)
         {
-            int InputSize = input->Length;
-            if(!input)
-                throw gcnew ArgumentNullException("input", "Value cannot be null.");
-            if(startIndex < 0 || startIndex > InputSize)
-                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
-            if(length < 0 || length > InputSize)
-                throw gcnew ArgumentOutOfRangeException("length", "Length cannot be less than 0 or greater than input length.");
-            if(startIndex + length - 1 > InputSize)
-                throw gcnew ArgumentOutOfRangeException("startIndex, length", "Start index and length combined cannot be greater than input length.");
-            if(startIndex > 0)
-            {
-                pin_ptr<const wchar_t> chars = PtrToStringChars(input);
-                if((((char*)(&chars[startIndex]))[1] & 0xdc) == 0xdc)
-                    throw gcnew ArgumentException("startIndex", "Start index cannot bisect a UTF-16 surrogate pair.");
-            }
-            
-            /* If in UTF-8 mode, convert the start and length values from String^ to char* offset. */
-            bool isUtf8 = !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING);
+            if(!RegexOption::HasAnyFlag(options, RegexOptions::Literal) || RegexOption::HasAnyFlag(options, RegexOptions::IgnoreNewline))
+                return nullptr;
 
-            StringPiece* sp = ConvertStringEncoding(input, "input", this->Options);
-            RegexInput^  ri = gcnew RegexInput(input, sp->data(), sp->length(), isUtf8);
-            delete sp;
+            bool ignoreCase = RegexOption::HasAnyFlag(options, RegexOptions::IgnoreCase);
+            bool isUtf8     = !RegexOption::HasAnyFlag(options, SINGLE_BYTE_ENCODING);
+            bool hasChars   = isUtf8;
 
-            int strStartIndex = startIndex;
-            if(isUtf8)
+            for(int i = 0; i < pattern->Length; i++)
             {
-                if(startIndex) startIndex = StrToCharPos(ri->Data, startIndex);
-                if(length)     length     = StrToCharPos(ri->Data + startIndex, length);
+                wchar_t c = pattern[i];
+                if(ignoreCase && (c >= 0x80 || (isUtf8 && wcschr(L"kKsS", c))))
+                    return nullptr;
+                /* stringToUTF8 doesn't check surrogates, so a pattern with any is only searched as bytes. */
+                if(c >= 0xd800 && c <= 0xdfff)
+                    hasChars = false;
             }
 
-            return this->_match(ri, startIndex, length, strStartIndex);
+            StringPiece* sp = ConvertStringEncoding(pattern, "pattern", options);
+            pin_ptr<const wchar_t> chars = PtrToStringChars(pattern);
+
+            SubstringSearch* rv = new SubstringSearch(sp->data(), sp->length(), hasChars ? static_cast<const wchar_t*>(chars) : nullptr, pattern->Length, ignoreCase);
+            free(const_cast<char*>(sp->data()));
+            delete sp;
+
+            return rv;
         }
 
 
-        _Match^ Regex::Match(array<Byte>^ input, int startIndex, int length)
+        /* One item of a pattern analyzed by CreateInnerLiteral. */
+        struct PatternItem
         {
-            if(!input)
-                throw gcnew ArgumentNullException("input", "Value cannot be null.");
-            if(startIndex < 0 || startIndex > input->Length)
-                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
-            if(length < 0 || length > input->Length)
-                throw gcnew ArgumentOutOfRangeException("length", "Length cannot be less than 0 or greater than input length.");
-            if(startIndex + length - 1 > input->Length)
-                throw gcnew ArgumentOutOfRangeException("startIndex, length", "Start index and length combined cannot be greater than input length.");
+            bool   bytes[256];  /* The bytes the item can match. */
+            int    width;       /* The most bytes one repetition can match. */
+            int    min;
+            int    max;         /* -1 if unlimited. */
+            string literal;     /* The encoded character, if the item is a literal character. */
+        };
+
 
-            RegexInput^ ri = gcnew RegexInput(input, !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING));
+        static void AddRange(PatternItem& item, wchar_t first, wchar_t last, bool isUtf8)
+        {
+            for(int c = first; c <= last && c <= (isUtf8 ? 0x7f : 0xff); c++)
+                item.bytes[c] = true;
 
-            /* Unicode hijinks aren't required for byte arrays. */
-            return this->_match(ri, startIndex, length, 0);
+            /* Any byte of a multibyte character. */
+            if(isUtf8 && last >= 0x80)
+            {
+                for(int c = 0x80; c <= 0xff; c++)
+                    item.bytes[c] = true;
+                item.width = 4;
+            }
         }
 
 
-        _Match^ Regex::Match(String^ input, int startIndex)
+        /* \d, \w, and \s are ASCII-only in RE2; \D, \W, and \S match every other character. */
+        static void AddPerlClass(PatternItem& item, wchar_t c, bool isUtf8)
         {
-            return this->Match(input, startIndex, input->Length - startIndex);
+            wchar_t lower = c | 0x20;
+            for(int b = 0; b < 0x80; b++)
+            {
+                bool in = lower == 'd' ? b >= '0' && b <= '9' :
+                          lower == 'w' ? (b >= '0' && b <= '9') || (b >= 'a' && b <= 'z') || (b >= 'A' && b <= 'Z') || b == '_' :
+                                         b == ' ' || b == '\t' || b == '\n' || b == '\f' || b == '\r';
+                if(in == (c == lower))
+                    item.bytes[b] = true;
+            }
+            if(c != lower)
+                AddRange(item, 0x80, 0xff, isUtf8);
         }
 
 
-        _Match^ Regex::Match(array<Byte>^ input, int startIndex)
+        static void AddLiteral(PatternItem& item, wchar_t c, bool isUtf8)
         {
-            return this->Match(input, startIndex, input->Length - startIndex);
+            if(!isUtf8 || c < 0x80)
+                item.literal = string(1, static_cast<char>(c));
+            else if(c < 0x800)
+                item.literal = { static_cast<char>(0xc0 | c >> 6), static_cast<char>(0x80 | (c & 0x3f)) };
+            else
+                item.literal = { static_cast<char>(0xe0 | c >> 12), static_cast<char>(0x80 | (c >> 6 & 0x3f)), static_cast<char>(0x80 | (c & 0x3f)) };
+
+            for(size_t i = 0; i < item.literal.size(); i++)
+                item.bytes[static_cast<unsigned char>(item.literal[i])] = true;
+            item.width = static_cast<int>(item.literal.size());
         }
 
 
-        _Match^ Regex::Match(String^ input)
+        /* Parses a class after its '['. Returns false for syntax not handled here, such as "[[:alpha:]]". */
+        static bool ParseClass(String^ pattern, int& i, bool isUtf8, PatternItem& item)
         {
-            return this->Match(input, 0, input->Length);
-        }
+            bool negated = i < pattern->Length && pattern[i] == '^';
+            if(negated)
+                i++;
 
+            for(bool first = true; ; first = false)
+            {
+                if(i == pattern->Length)
+                    return false;
+
+                wchar_t c = pattern[i++];
+                if(c == ']' && !first)
+                    break;
+                if(c == '[' || (c >= 0xd800 && c <= 0xdfff))
+                    return false;
+                if(c == '\\')
+                {
+                    if(i == pattern->Length)
+                        return false;
+                    c = pattern[i++];
+                    if(c && wcschr(L"dDwWsS", c))
+                    {
+                        AddPerlClass(item, c, isUtf8);
+                        continue;
+                    }
+                    if(c == 'n' || c == 't' || c == 'r')
+                        c = c == 'n' ? '\n' : c == 't' ? '\t' : '\r';
+                    else if(c >= 0x80 || Char::IsLetterOrDigit(c))
+                        return false;
+                }
 
-        _Match^ Regex::Match(array<Byte>^ input)
-        {
-            return this->Match(input, 0, input->Length);
+                wchar_t last = c;
+                if(i + 1 < pattern->Length && pattern[i] == '-' && pattern[i + 1] != ']')
+                {
+                    last = pattern[i + 1];
+                    i   += 2;
+                    if(last == '\\' || last == '[' || last < c || (last >= 0xd800 && last <= 0xdfff))
+                        return false;
+                }
+                AddRange(item, c, last, isUtf8);
+            }
+
+            if(negated)
+            {
+                for(int b = 0; b <= 0xff; b++)
+                    item.bytes[b] = !item.bytes[b];
+                if(isUtf8)
+                    AddRange(item, 0x80, 0xff, isUtf8);
+            }
+            return true;
         }
 
 
-        _Match^ Regex::Match(String^ input, String^ pattern, RegexOptions options)
+        /* Parses a repetition after its '{'. RE2 allows at most 1000. */
+        static bool ParseRepeat(String^ pattern, int& i, int& min, int& max)
         {
-            return Cache::FindOrCreate(pattern, options)->Match(input);
+            int  values[2] = { -1, -1 };
+            bool range     = false;
+
+            for(int* value = values; i < pattern->Length; i++)
+            {
+                wchar_t c = pattern[i];
+                if(c >= '0' && c <= '9')
+                {
+                    *value = (*value < 0 ? 0 : *value * 10) + (c - '0');
+                    if(*value > 1000)
+                        return false;
+                }
+                else if(c == ',' && !range)
+                {
+                    range = true;
+                    value = values + 1;
+                }
+                else if(c == '}' && values[0] >= 0)
+                {
+                    i++;
+                    min = values[0];
+                    max = !range ? values[0] : values[1];
+                    return max < 0 || max >= min;
+                }
+                else
+                    return false;
+            }
+            return false;
         }
 
 
-        _Match^ Regex::Match(array<Byte>^ input, String^ pattern, RegexOptions options)
+        /* Adds what an item can match to a running total, or returns -1 if either is unlimited. */
+        static int AddLength(int total, const PatternItem& item)
         {
-            return Cache::FindOrCreate(pattern, options)->Match(input);
+            if(total < 0 || item.max < 0)
+                return -1;
+            total += item.width * item.max;
+            return total < (1 << 20) ? total : -1;
         }
 
 
-        _Match^ Regex::Match(String^ input, String^ pattern)
+        /*
+         *  Parses a pattern that is a sequence of literal characters, '.', classes, and Perl classes, each
+         *  optionally repeated, between an optional '^' and '$'. Returns false for anything else, such as
+         *  groups, alternations, and other assertions, which are left to RE2.
+         */
+        static bool ParsePattern(String^ pattern, RegexOptions options, std::vector<PatternItem>& items, bool& anchorStart, bool& anchorEnd)
         {
-            return Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input);
-        }
+            bool isUtf8 = !RegexOption::HasAnyFlag(options, SINGLE_BYTE_ENCODING);
 
+            anchorStart = false;
+            anchorEnd   = false;
 
-        _Match^ Regex::Match(array<Byte>^ input, String^ pattern)
-        {
-            return Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input);
-        }
+            for(int i = 0; i < pattern->Length; )
+            {
+                PatternItem item = {};
+                item.width = 1;
+                item.min   = 1;
+                item.max   = 1;
 
-        #pragma endregion
+                wchar_t c = pattern[i++];
+                if(c == '[')
+                {
+                    if(!ParseClass(pattern, i, isUtf8, item))
+                        return false;
+                }
+                else if(c == '.')
+                {
+                    AddRange(item, 0, 0xff, isUtf8);
+                    item.bytes['\n'] = RegexOption::HasAnyFlag(options, RegexOptions::Singleline);
+                }
+                else if(c == '\\')
+                {
+                    if(i == pattern->Length)
+                        return false;
+                    c = pattern[i++];
+                    if(c && wcschr(L"dDwWsS", c))
+                        AddPerlClass(item, c, isUtf8);
+                    else if(c == 'n' || c == 't' || c == 'r')
+                        AddLiteral(item, c == 'n' ? '\n' : c == 't' ? '\t' : '\r', isUtf8);
+                    else if(c < 0x80 && !Char::IsLetterOrDigit(c))
+                        AddLiteral(item, c, isUtf8);
+                    else
+                        return false;
+                }
+                else if(c == '^' && i == 1)
+                {
+                    anchorStart = true;
+                    continue;
+                }
+                else if(c == '$' && i == pattern->Length && !items.empty())
+                {
+                    anchorEnd = true;
+                    break;
+                }
+                else if(!c || wcschr(L"()|^$*+?{}]", c) || (c >= 0xd800 && c <= 0xdfff))
+                    return false;
+                else
+                    AddLiteral(item, c, isUtf8);
 
+                if(i < pattern->Length && pattern[i] && wcschr(L"?*+{", pattern[i]))
+                {
+                    wchar_t repeat = pattern[i++];
+                    if(repeat == '?')
+                        item.min = 0;
+                    else if(repeat == '*')
+                    {
+                        item.min = 0;
+                        item.max = -1;
+                    }
+                    else if(repeat == '+')
+                        item.max = -1;
+                    else if(!ParseRepeat(pattern, i, item.min, item.max))
+                        return false;
 
-        #pragma region Matches
+                    /* Non-greedy repetitions match the same bytes. */
+                    if(i < pattern->Length && pattern[i] == '?')
+                        i++;
+                }
 
-        MatchCollection^ Regex::Matches(String^ input, int startIndex)
-        {
-            return gcnew MatchCollection(this->Match(input, startIndex, input->Length - startIndex));
+                items.push_back(item);
+            }
+
+            return true;
         }
 
 
-        MatchCollection^ Regex::Matches(array<Byte>^ input, int startIndex)
+        /*
+         *  Returns an InnerLiteral if the pattern parses, without anchors, and the longest run of
+         *  unrepeated literal characters in it is at least two bytes long and doesn't start the pattern.
+         *  (RE2 already skips ahead to a literal prefix.) Case folding is left to RE2.
+         */
+        static InnerLiteral* CreateInnerLiteral(String^ pattern, RegexOptions options)
         {
-            return gcnew MatchCollection(this->Match(input, startIndex, input->Length - startIndex));
-        }
+            if(RegexOption::HasAnyFlag(options, RegexOptions::IgnoreCase | RegexOptions::Literal | RegexOptions::IgnoreNewline))
+                return nullptr;
+
+            std::vector<PatternItem> items;
+            bool                     anchorStart;
+            bool                     anchorEnd;
+            if(!ParsePattern(pattern, options, items, anchorStart, anchorEnd) || anchorStart || anchorEnd)
+                return nullptr;
+
+            /* The longest run of literal characters that every match contains. */
+            size_t start  = 0;
+            size_t end    = 0;
+            size_t length = 0;
+            for(size_t i = 0; i < items.size(); )
+            {
+                size_t j     = i;
+                size_t bytes = 0;
+                for(; j < items.size() && !items[j].literal.empty() && items[j].min == 1 && items[j].max == 1; j++)
+                    bytes += items[j].literal.size();
 
+                if(bytes > length)
+                {
+                    start  = i;
+                    end    = j;
+                    length = bytes;
+                }
+                i = j > i ? j : i + 1;
+            }
 
-        MatchCollection^ Regex::Matches(String^ input)
-        {
-            return gcnew MatchCollection(this->Match(input, 0, input->Length));
-        }
+            if(!start || length < 2)
+                return nullptr;
 
+            string literal;
+            bool   prefixBytes[256] = {};
+            int    maxPrefix        = 0;
+            int    maxSuffix        = 0;
 
-        MatchCollection^ Regex::Matches(array<Byte>^ input)
-        {
-            return gcnew MatchCollection(this->Match(input, 0, input->Length));
+            for(size_t i = 0; i < start; i++)
+            {
+                for(int b = 0; b <= 0xff; b++)
+                    prefixBytes[b] |= items[i].bytes[b];
+                maxPrefix = AddLength(maxPrefix, items[i]);
+            }
+            for(size_t i = start; i < end; i++)
+                literal += items[i].literal;
+            for(size_t i = end; i < items.size(); i++)
+                maxSuffix = AddLength(maxSuffix, items[i]);
+
+            return new InnerLiteral(literal, prefixBytes, maxPrefix, maxSuffix);
         }
 
 
-        MatchCollection^ Regex::Matches(String^ input, String^ pattern, RegexOptions options)
+        /*
+         *  Returns a ShiftAnd if the pattern parses, has a counted repetition such as {20} (which RE2's
+         *  DFA tracks as a separate state for every count), fits in ShiftAnd::MAX_POSITIONS positions,
+         *  and can't match an empty string. Case folding is left to RE2, as are non-ASCII literals in
+         *  UTF-8 mode, which span several positions.
+         */
+        static ShiftAnd* CreateShiftAnd(String^ pattern, RegexOptions options)
         {
-            return gcnew MatchCollection(Cache::FindOrCreate(pattern, options)->Match(input, 0, input->Length));
-        }
+            if(RegexOption::HasAnyFlag(options, RegexOptions::IgnoreCase | RegexOptions::Literal | RegexOptions::IgnoreNewline))
+                return nullptr;
 
+            std::vector<PatternItem> items;
+            bool                     anchorStart;
+            bool                     anchorEnd;
+            if(!ParsePattern(pattern, options, items, anchorStart, anchorEnd))
+                return nullptr;
 
-        MatchCollection^ Regex::Matches(array<Byte>^ input, String^ pattern, RegexOptions options)
-        {
-            return gcnew MatchCollection(Cache::FindOrCreate(pattern, options)->Match(input, 0, input->Length));
-        }
+            std::vector<ShiftAnd::Position> positions;
+            bool                            counted = false;
+            bool                            empty   = true;
 
+            for(size_t i = 0; i < items.size(); i++)
+            {
+                const PatternItem& item = items[i];
+                if(item.literal.size() > 1)
+                    return nullptr;
 
-        MatchCollection^ Regex::Matches(String^ input, String^ pattern)
-        {
-            return gcnew MatchCollection(Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input, 0, input->Length));
+                counted |= item.min > 1 || item.max > 1;
+                empty   &= !item.min;
+
+                /* x{2,4} is x, x, x?, x?; x+ is x with a loop; x* is x? with a loop. */
+                ShiftAnd::Position position;
+                memcpy(position.bytes, item.bytes, sizeof(position.bytes));
+
+                int required = item.max < 0 && !item.min ? 1 : item.min;
+                int optional = item.max < 0 ? 0 : item.max - item.min;
+                if(positions.size() + required + optional > ShiftAnd::MAX_POSITIONS)
+                    return nullptr;
+
+                for(int j = 0; j < required + optional; j++)
+                {
+                    position.optional = j >= item.min;
+                    position.loop     = item.max < 0 && j == required - 1;
+                    positions.push_back(position);
+                }
+            }
+
+            if(!counted || empty)
+                return nullptr;
+
+            /* Without OneLine, POSIX syntax has '^' and '$' match at lines, as Multiline does. */
+            bool lineAnchors = RegexOption::HasAnyFlag(options, RegexOptions::Multiline) ||
+                               (RegexOption::HasAnyFlag(options, RegexOptions::POSIX) && !RegexOption::HasAnyFlag(options, RegexOptions::OneLine));
+
+            return new ShiftAnd(positions, anchorStart, anchorEnd, lineAnchors, !RegexOption::HasAnyFlag(options, SINGLE_BYTE_ENCODING));
         }
 
 
-        MatchCollection^ Regex::Matches(array<Byte>^ input, String^ pattern)
+        /*
+         *  Rewrites the unnamed groups of a pattern as non-capturing groups, for ExplicitCapture.
+         *  Escapes, \Q...\E, and classes are copied as they are, so that only a '(' that opens a
+         *  group is rewritten. "(?" already opens a named or non-capturing group, or sets flags.
+         */
+        static String^ RemoveUnnamedCaptures(String^ pattern)
         {
-            return gcnew MatchCollection(Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input, 0, input->Length));
-        }
+            StringBuilder^ rewritten = gcnew StringBuilder(pattern->Length + 16);
 
-        #pragma endregion
+            for(int i = 0; i < pattern->Length; i++)
+            {
+                wchar_t c = pattern[i];
+                rewritten->Append(c);
 
-    #pragma endregion
+                if(c == '\\' && i + 1 < pattern->Length)
+                {
+                    if(pattern[++i] == 'Q')
+                    {
+                        int end = pattern->IndexOf("\\E", i, StringComparison::Ordinal);
+                        end = end < 0 ? pattern->Length : end + 2;
+                        rewritten->Append(pattern, i, end - i);
+                        i = end - 1;
+                    }
+                    else rewritten->Append(pattern[i]);
+                }
+                else if(c == '[')
+                {
+                    /* A ']' right after "[" or "[^" is a literal, and "[:alpha:]" can appear inside a class. */
+                    int end = i + 1;
+                    if(end < pattern->Length && pattern[end] == '^')
+                        end++;
+                    for(bool first = true; end < pattern->Length; first = false)
+                    {
+                        if(pattern[end] == '\\')
+                        {
+                            end += 2;
+                        }
+                        else if(pattern[end] == '[' && end + 1 < pattern->Length && pattern[end + 1] == ':')
+                        {
+                            int close = pattern->IndexOf(":]", end + 2, StringComparison::Ordinal);
+                            end = close < 0 ? pattern->Length : close + 2;
+                        }
+                        else if(pattern[end++] == ']' && !first)
+                            break;
+                    }
+                    /* An unterminated class is left for RE2 to report. */
+                    end = Math::Min(end, pattern->Length);
+                    rewritten->Append(pattern, i + 1, end - i - 1);
+                    i = end - 1;
+                }
+                else if(c == '(' && (i + 1 == pattern->Length || pattern[i + 1] != '?'))
+                    rewritten->Append("?:");
+            }
 
+            return rewritten->ToString();
+        }
 
-    #pragma region Regex constructors and cleanup
 
         Regex::Regex(String^ pattern, RegexOptions options, int maxMemory)
-            : _re2(nullptr), _pattern(pattern), _options(options), _maxMemory(maxMemory)
+            : _re2(nullptr), _handle(nullptr), _literals(nullptr), _substring(nullptr), _inner(nullptr), _shiftAnd(nullptr), _replicas(nullptr), _pattern(pattern), _options(options), _maxMemory(maxMemory)
         {
             if(!pattern)
                 throw gcnew ArgumentNullException("pattern", "Value cannot be null.");
-            if(options < RegexOptions::None || options > REGEX_OPTIONS_MAX)
+            if((options & ~REGEX_OPTIONS_ALL) != RegexOptions::None)
                 throw gcnew ArgumentOutOfRangeException("options", "Specified argument was outside the range of valid RegexOptions values.");
             /*
              * // maxMemory is not validated because RE2 permits maxMemory values <= 0. (See
@@ -712,10 +2974,12 @@ namespace Net
                 settings.set_one_line      ( RegexOption::HasAnyFlag(options, RegexOptions::OneLine));
 
                 /*
-                 *  never_capture is a recent addition to RE2 and will be added to Re2.Net if it allows
-                 *  support for .NET's RegexOptions.ExplicitCapture flag.
+                 *  RE2's never_capture would drop named groups too, which ExplicitCapture keeps, so unnamed
+                 *  groups are rewritten instead. POSIX syntax has no "(?:" to rewrite them as.
                  */
-                //settings.set_never_capture ( RegexOption::HasAnyFlag(options, RegexOptions::ExplicitCapture));
+                if(RegexOption::HasAnyFlag(options, RegexOptions::ExplicitCapture) &&
+                   !RegexOption::HasAnyFlag(options, RegexOptions::Literal | RegexOptions::POSIX))
+                    pattern = RemoveUnnamedCaptures(pattern);
 
                 /*
                  *  RE2 only accepts some options inline, so they're inserted at the front of
@@ -739,7 +3003,8 @@ namespace Net
                 if(RegexOption::HasAnyFlag(options, RegexOptions::Ungreedy))
                     flags->Append("U");
 
-                if(flags->Length > 0)
+                /* A Literal pattern would match the flags as text. */
+                if(flags->Length > 0 && !RegexOption::HasAnyFlag(options, RegexOptions::Literal))
                 {
                     flags->Insert(0, "(?");
                     flags->Append(")");
@@ -753,15 +3018,41 @@ namespace Net
              *  to be freed manually.
              */
             StringPiece* regex = ConvertStringEncoding(pattern, "pattern", options);
-            _re2 = new RE2(*regex, settings);
+            _re2    = new RE2(*regex, settings);
+            _handle = gcnew RE2Handle(_re2);
             free(const_cast<char*>(regex->data()));
             delete regex;
 
             if(!_re2->ok())
-                throw gcnew ArgumentException(String::Format("{0}: '{1}' in pattern '{2}'.",
-                                                             _errorTable[_re2->error_code()],
-                                                             CharToString(_re2->error_arg(), settings.utf8()),
-                                                             Pattern));
+            {
+                String^ message = String::Format("{0}: '{1}' in pattern '{2}'.",
+                                                 _errorTable[_re2->error_code()],
+                                                 CharToString(_re2->error_arg(), settings.utf8()),
+                                                 Pattern);
+                /* No reason to leave a failed RE2 for the finalizer. */
+                delete _handle;
+                _re2 = nullptr;
+                throw gcnew ArgumentException(message);
+            }
+
+            _literals            = CreateLiteralSearch(_pattern, options);
+            _handle->Literals    = _literals;
+            _substring           = CreateSubstringSearch(_pattern, options);
+            _handle->Substring   = _substring;
+            _inner               = CreateInnerLiteral(_pattern, options);
+            _handle->Inner       = _inner;
+            _shiftAnd            = _inner ? nullptr : CreateShiftAnd(_pattern, options);
+            _handle->BitParallel = _shiftAnd;
+            _telemetry           = RegexOption::HasAnyFlag(options, RegexOptions::Telemetry) ? gcnew RegexTelemetry(_pattern) : nullptr;
+
+            if(RegexOption::HasAnyFlag(options, RegexOptions::ThreadReplicas))
+            {
+                _replicas     = gcnew array<IntPtr>(Environment::ProcessorCount);
+                _replicas[0]  = IntPtr(const_cast<RE2*>(_re2));
+                _replicaCount = 1;
+
+                _handle->Replicas = _replicas;
+            }
         }
 
 
@@ -777,9 +3068,12 @@ namespace Net
         }
 
 
-        /* Initialize error code message lookup table. */
+        /* Initialize the mask of valid options and the error code message lookup table. */
         static Regex::Regex()
         {
+            for each(RegexOptions option in Enum::GetValues(RegexOptions::typeid))
+                REGEX_OPTIONS_ALL = REGEX_OPTIONS_ALL | option;
+
             _errorTable[RE2::ErrorInternal]          = "An unknown internal error has occurred";
             _errorTable[RE2::ErrorBadEscape]         = "Invalid escape sequence";
             _errorTable[RE2::ErrorBadCharClass]      = "Invalid character class";
@@ -799,14 +3093,35 @@ namespace Net
 
         Regex::~Regex()
         {
-            this->!Regex();
+            if(_handle)
+                delete _handle;
+        }
+
+
+        Regex::RE2Handle::RE2Handle(const RE2* re2)
+            : SafeHandleZeroOrMinusOneIsInvalid(true)
+        {
+            this->SetHandle(IntPtr(const_cast<RE2*>(re2)));
         }
 
 
-        Regex::!Regex()
+        bool Regex::RE2Handle::ReleaseHandle()
         {
-            if(_re2)
-                delete _re2;
+            /* Slot 0 is the handle itself, which is deleted below. */
+            if(Replicas)
+                for(int i = 1; i < Replicas->Length; i++)
+                    if(Replicas[i] != IntPtr::Zero)
+                    {
+                        delete static_cast<RE2*>(Replicas[i].ToPointer());
+                        Replicas[i] = IntPtr::Zero;
+                    }
+
+            delete Literals;
+            delete Substring;
+            delete Inner;
+            delete BitParallel;
+            delete static_cast<RE2*>(this->handle.ToPointer());
+            return true;
         }
 
     #pragma endregion
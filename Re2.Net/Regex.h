@@ -107,6 +107,8 @@
 
 #include "RegexOptions.h"
 #include "RegexInput.h"
+#include "MatchStrategy.h"
+#include "NumberBase.h"
 #include "Match.h"
 #include "MatchCollection.h"
 
@@ -118,13 +120,29 @@ namespace Net
     using namespace System;
 
     using System::Collections::Generic::Dictionary;
+    using System::Collections::Generic::IEnumerable;
+    using System::Collections::Generic::IList;
     using System::Collections::Generic::List;
+    using System::Runtime::InteropServices::OutAttribute;
+    using System::Threading::Tasks::ParallelLoopState;
+    using System::Threading::Tasks::Task;
+
+    using Microsoft::Win32::SafeHandles::SafeHandleZeroOrMinusOneIsInvalid;
 
     using re2::RE2;
     using re2::StringPiece;
 
     ref class Match;
     ref class MatchCollection;
+    ref class RegexTelemetry;
+
+    /* Native literal searchers. See LiteralSearch.h. */
+    class LiteralSearch;
+    class SubstringSearch;
+    class InnerLiteral;
+
+    /* A native bit-parallel matcher. See ShiftAnd.h. */
+    class ShiftAnd;
 
     /*
      *  The compiler is unable to distinguish between types and members
@@ -144,21 +162,95 @@ namespace Net
         private:
 
             /*
-             *  _re2 : The internal RE2 object. Don't call MemberwiseClone() on Regex instances.
-             *         (Note that the class itself is sealed to prevent users from doing this.)
+             *  Owns _re2 and its replicas in place of a finalizer on Regex. See NativeBuffer in
+             *  RegexInput.h for why.
+             */
+            ref class RE2Handle sealed : SafeHandleZeroOrMinusOneIsInvalid
+            {
+                internal:
+
+                    array<IntPtr>^         Replicas;
+                    const LiteralSearch*   Literals;
+                    const SubstringSearch* Substring;
+                    const InnerLiteral*    Inner;
+                    const ShiftAnd*        BitParallel;
+
+                    RE2Handle(const RE2* re2);
+
+
+                protected:
+
+                    virtual bool ReleaseHandle() override;
+            };
+
+
+            /*
+             *  _re2    : The internal RE2 object. Don't call MemberwiseClone() on Regex instances.
+             *            (Note that the class itself is sealed to prevent users from doing this.)
+             *
+             *  _handle : Owns _re2. Code passing _re2 to native code must keep the Regex alive
+             *            until the call ends, or the handle may release it mid-call.
+             *
+             *  _literals : If the pattern is nothing but an alternation of literals, finds where
+             *              a match starts without RE2. Also owned by _handle. nullptr otherwise.
+             *
+             *  _substring : If RegexOptions::Literal is set and the options allow it, finds matches
+             *               in place of RE2. Also owned by _handle. nullptr otherwise.
+             *
+             *  _inner : If every match contains a literal past the start of the pattern, finds where
+             *           RE2 needs to search. Also owned by _handle. nullptr otherwise.
+             *
+             *  _shiftAnd : If the pattern is short, capture-free, and has a counted repetition, decides
+             *              whether there's a match, and where it starts, in place of RE2. Also owned by
+             *              _handle. nullptr otherwise.
+             */
+            const RE2*             _re2;
+            RE2Handle^             _handle;
+            const LiteralSearch*   _literals;
+            const SubstringSearch* _substring;
+            const InnerLiteral*    _inner;
+            const ShiftAnd*        _shiftAnd;
+
+
+            /*
+             *  _replicas     : Copies of _re2 for RegexOptions::ThreadReplicas, one slot per processor,
+             *                  filled on first use. Slot 0 is _re2 itself. nullptr if the option isn't set.
+             *
+             *  _replicaCount : The number of filled slots.
+             *
+             *  _threadSlot   : The current thread's ticket, shared by all Regex instances. Zero until
+             *                  the thread first matches against a replicated Regex.
+             *
+             *  _threadCount  : The last ticket handed out.
              */
-            const RE2* _re2;
+            array<IntPtr>^ _replicas;
+            int            _replicaCount;
+
+            [ThreadStatic]
+            static int _threadSlot;
+            static int _threadCount;
+
+
+            /* Counters for RegexOptions::Telemetry. nullptr if the option isn't set. */
+            RegexTelemetry^ _telemetry;
 
 
             /*
-             *  REGEX_OPTIONS_MAX    : The upper bound on valid RegexOptions input. The lower bound is
-             *                         always zero, represented by RegexOptions::None.
+             *  REGEX_OPTIONS_ALL    : Every defined RegexOptions flag. Any other bit is invalid input.
              *
              *  SINGLE_BYTE_ENCODING : RegexOptions set to either of the available single-byte encodings.
              */
-            static initonly RegexOptions REGEX_OPTIONS_MAX    = RegexOptions(1 << (Enum::GetNames(RegexOptions::typeid)->Length - 2));
+            static initonly RegexOptions REGEX_OPTIONS_ALL;
             static initonly RegexOptions SINGLE_BYTE_ENCODING = RegexOptions::Latin1 | RegexOptions::ASCII;
 
+
+            /*
+             *  Returns the RE2 object the calling thread should match with: _re2, or the thread's
+             *  replica if RegexOptions::ThreadReplicas is set.
+             */
+            const RE2* _engine();
+            IntPtr     _replicate(int slot);
+
         #pragma endregion
 
 
@@ -180,6 +272,37 @@ namespace Net
                     static Dictionary<String^, Regex^> _map;
                     static List<Regex^>                _list;
 
+                    /*
+                     *  _usage     : The number of FindOrCreate calls per key while _recording is set, whether
+                     *               they hit or missed, plus the counts read from manifests. Kept for keys
+                     *               that have since been evicted.
+                     *
+                     *  _recording : Set by Regex::RecordCacheUsage.
+                     */
+                    static Dictionary<String^, Int64> _usage;
+                    static bool                       _recording;
+
+                    /* Guards _map, _list, and _usage. Expressions are never compiled while it's held. */
+                    static initonly Object^ _lock = gcnew Object();
+
+                    /* Adds or replaces an entry, evicting the oldest if the cache is full. The caller holds _lock. */
+                    static void _add(String^ key, Regex^ regex);
+
+                    /* Compiles the entries read from a manifest for Load, on a thread-pool thread. */
+                    ref class Preload sealed
+                    {
+                        private:
+
+                            List<Tuple<String^, RegexOptions, int>^>^ _definitions;
+
+
+                        internal:
+
+                            Preload(List<Tuple<String^, RegexOptions, int>^>^ definitions);
+
+                            void Run();
+                    };
+
 
                 internal:
 
@@ -195,6 +318,26 @@ namespace Net
                      *      regex, both the pattern and the options are taken into account.
                      */
                     static Regex^ FindOrCreate(String^ pattern, RegexOptions options);
+
+                    /*
+                     *  Adds an already compiled regex to the cache, replacing any cached regex with
+                     *  the same pattern and options.
+                     */
+                    static void Add(Regex^ regex);
+
+                    static property bool Recording { bool get(); void set(bool value); }
+
+                    /*
+                     *  Writes _usage to a manifest, most used first, one "count<TAB>options<TAB>pattern" line
+                     *  per key. '%', CR, and LF in patterns are percent-encoded to keep each on its line.
+                     */
+                    static void Save(String^ path);
+
+                    /*
+                     *  Reads a manifest written by Save, adds its counts to _usage, and precompiles its most
+                     *  used entries into the cache in the background.
+                     */
+                    static Task^ Load(String^ path, int maxEntries);
             };
 
 
@@ -215,6 +358,99 @@ namespace Net
                 void set(int value);
             }
 
+
+            /// <summary>
+            ///     Gets or sets a value that indicates whether the static matching methods record how often each pattern and
+            ///     set of options is used, for <see cref="SaveCacheManifest"/>.
+            /// </summary>
+            /// <value>
+            ///     <c>true</c> if usage is recorded; otherwise, <c>false</c>. The default is <c>false</c>.
+            /// </value>
+            /// <remarks>
+            ///     Usage is counted per call to a static matching method, whether or not the expression was already cached, and
+            ///     is kept for expressions that have since been evicted from the cache.
+            /// </remarks>
+            static property bool RecordCacheUsage
+            {
+                bool get();
+                void set(bool value);
+            }
+
+
+            /// <summary>
+            ///     Writes the recorded usage of the static cache to a manifest file, to be loaded with
+            ///     <see cref="LoadCacheManifest(String)"/> on the next startup.
+            /// </summary>
+            /// <param name="path">The file to write. An existing file is overwritten.</param>
+            /// <remarks>
+            ///     The manifest is a UTF-8 text file with one line per pattern and set of options, most used first. Usage is only
+            ///     recorded while <see cref="RecordCacheUsage"/> is <c>true</c>, plus whatever was read with
+            ///     <c>LoadCacheManifest</c>.
+            /// </remarks>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="path"/> is <c>null</c>.
+            /// </exception>
+            /// <exception cref="System::IO::IOException">
+            ///     The file could not be written.
+            /// </exception>
+            static void SaveCacheManifest(String^ path);
+
+
+            /// <summary>
+            ///     Reads a manifest written by <see cref="SaveCacheManifest"/>, and compiles its most used expressions into the
+            ///     static cache on a thread-pool thread.
+            /// </summary>
+            /// <param name="path">The manifest file. If it doesn't exist, nothing is loaded.</param>
+            /// <param name="maxEntries">
+            ///     The maximum number of expressions to compile. No more than <see cref="CacheSize"/> are compiled in any case.
+            /// </param>
+            /// <returns>A task that completes when the expressions are in the cache.</returns>
+            /// <remarks>
+            ///     <para>
+            ///         The file is read before this method returns; only compilation happens in the background, in parallel.
+            ///         The most used expressions are added to the cache last, so that they are the last to be evicted. Entries
+            ///         that no longer compile are skipped.
+            ///     </para>
+            ///     <para>
+            ///         The counts in the manifest are added to the recorded usage, so that a manifest saved later covers this
+            ///         run and the ones before it.
+            ///     </para>
+            /// </remarks>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="path"/> is <c>null</c>.
+            /// </exception>
+            /// <exception cref="System::ArgumentOutOfRangeException">
+            ///     <paramref name="maxEntries"/> is less than zero.
+            /// </exception>
+            /// <exception cref="System::FormatException">
+            ///     The file is not a valid manifest.
+            /// </exception>
+            /// <exception cref="System::IO::IOException">
+            ///     The file could not be read.
+            /// </exception>
+            static Task^ LoadCacheManifest(String^ path, int maxEntries);
+
+
+            /// <summary>
+            ///     Reads a manifest written by <see cref="SaveCacheManifest"/>, and compiles up to <see cref="CacheSize"/> of its
+            ///     most used expressions into the static cache on a thread-pool thread.
+            /// </summary>
+            /// <param name="path">The manifest file. If it doesn't exist, nothing is loaded.</param>
+            /// <returns>A task that completes when the expressions are in the cache.</returns>
+            /// <remarks>
+            ///     See <see cref="LoadCacheManifest(String, int)"/>.
+            /// </remarks>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="path"/> is <c>null</c>.
+            /// </exception>
+            /// <exception cref="System::FormatException">
+            ///     The file is not a valid manifest.
+            /// </exception>
+            /// <exception cref="System::IO::IOException">
+            ///     The file could not be read.
+            /// </exception>
+            static Task^ LoadCacheManifest(String^ path);
+
         #pragma endregion
             
 
@@ -255,6 +491,76 @@ namespace Net
             property int MaxMemory { int get(); }
 
 
+            /// <summary>
+            ///     Gets the number of compiled copies of the expression currently in use.
+            /// </summary>
+            /// <value>
+            ///     1, unless <see cref="RegexOptions::ThreadReplicas"/> is set, in which case copies are
+            ///     added as new threads match against the current instance, up to the number of processors.
+            /// </value>
+            property int ReplicaCount { int get(); }
+
+
+            /// <summary>
+            ///     Gets the maximum memory that can be used by all copies of the expression.
+            /// </summary>
+            /// <value>
+            ///     <see cref="MaxMemory"/> multiplied by <see cref="ReplicaCount"/>.
+            /// </value>
+            property Int64 MemoryBudget { Int64 get(); }
+
+
+            /// <summary>
+            ///     Gets how the current instance searches its input.
+            /// </summary>
+            /// <value>
+            ///     The strategy chosen from the pattern and options when the <c>Regex</c> was created.
+            /// </value>
+            property MatchStrategy Strategy { MatchStrategy get(); }
+
+
+            /// <summary>
+            ///     Gets the size of the compiled program, a rough measure of the cost of the regular expression.
+            /// </summary>
+            /// <value>
+            ///     The number of instructions in RE2's compiled program. Larger programs are slower to compile, take more
+            ///     memory, and fill the DFA cache sooner.
+            /// </value>
+            property int ProgramSize { int get(); }
+
+
+            /// <summary>
+            ///     Gets the number of capturing groups in the regular expression.
+            /// </summary>
+            /// <value>
+            ///     The number of capturing groups, not counting group 0, the entire match.
+            /// </value>
+            property int CapturingGroupCount { int get(); }
+
+
+            /// <summary>
+            ///     Gets the literal text that every match of the regular expression starts with.
+            /// </summary>
+            /// <value>
+            ///     The required prefix, up to 64 bytes long in the encoding of the <c>Regex</c>, or an empty string if matches
+            ///     can start with different text.
+            /// </value>
+            /// <remarks>
+            ///     The prefix is derived from <see cref="PossibleMatchRange"/>, so it is case-sensitive: with
+            ///     <see cref="RegexOptions::IgnoreCase"/> set, a pattern starting with a letter has no required prefix.
+            /// </remarks>
+            property String^ RequiredPrefix { String^ get(); }
+
+
+            /// <summary>
+            ///     Gets the call counts and phase timings of the current instance.
+            /// </summary>
+            /// <value>
+            ///     The counters, if <see cref="RegexOptions::Telemetry"/> is set; otherwise, <c>null</c>.
+            /// </value>
+            property RegexTelemetry^ Telemetry { RegexTelemetry^ get(); }
+
+
             /// <summary>
             ///     Returns the regular expression pattern that was passed into the <c>Regex</c> constructor.
             /// </summary>
@@ -444,23 +750,30 @@ namespace Net
             #pragma endregion
 
 
-            #pragma region Match
+            #pragma region FullMatch and PrefixMatch
 
-            internal:
-                
-                _Match^ _match(RegexInput^ input, int startIndex, int length, int stringStartIndex);
+            /*
+             *  The anchored counterparts of IsMatch(). Anchoring is passed to RE2 rather than written
+             *  into the pattern as '^...$', which lets RE2 skip the unanchored search machinery and use
+             *  its anchored fast paths.
+             */
+
+            private:
+
+                bool _anchoredMatch(String^ input, int startIndex, int length, RE2::Anchor anchor);
+                bool _anchoredMatch(array<Byte>^ input, int startIndex, int length, RE2::Anchor anchor);
 
 
             public:
 
                 /// <summary>
-                ///     Searches the input string for the first occurrence of a regular expression, beginning at the specified starting
-                ///     position and searching only the specified number of characters.
+                ///     Indicates whether the regular expression specified in the <c>Regex</c> constructor matches the entire the specified
+                ///     substring of the input string.
                 /// </summary>
-                /// <param name="input">The string to search for a match.</param>
-                /// <param name="startIndex">The input index at which to start the search.</param>
-                /// <param name="length">The number of characters in the substring to include in the search.</param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <param name="input">The string to match.</param>
+                /// <param name="startIndex">The input index at which the substring begins.</param>
+                /// <param name="length">The number of characters in the substring.</param>
+                /// <returns><c>true</c> if the regular expression matches the entire the substring; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> is <c>null</c>.
                 /// </exception>
@@ -475,17 +788,17 @@ namespace Net
                 ///     <para>- or -</para>
                 ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                _Match^ Match(String^ input, int startIndex, int length);
-                
+                bool FullMatch(String^ input, int startIndex, int length);
+
 
                 /// <summary>
-                ///     Searches the input byte array for the first occurrence of a regular expression, beginning at the specified starting
-                ///     position and searching only the specified number of bytes.
+                ///     Indicates whether the regular expression specified in the <c>Regex</c> constructor matches the entire the specified
+                ///     range of the input byte array.
                 /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
-                /// <param name="startIndex">The input index at which to start the search.</param>
-                /// <param name="length">The number of bytes in the input to include in the search.</param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <param name="input">The byte array to match.</param>
+                /// <param name="startIndex">The input index at which the range begins.</param>
+                /// <param name="length">The number of bytes in the range.</param>
+                /// <returns><c>true</c> if the regular expression matches the entire the range; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> is <c>null</c>.
                 /// </exception>
@@ -496,50 +809,15 @@ namespace Net
                 ///     <para>- or -</para>
                 ///     <para><c><paramref name="startIndex"/> + <paramref name="length"/>  1</c> identifies a position that is outside the range of <paramref name="input"/>.</para>
                 /// </exception>
-                _Match^ Match(array<Byte>^ input, int startIndex, int length);
-                
-
-                /// <summary>
-                ///     Searches the input string for the first occurrence of a regular expression, beginning at the specified starting
-                ///     position in the string.
-                /// </summary>
-                /// <param name="input">The string to search for a match.</param>
-                /// <param name="startIndex">The zero-based input index at which to start the search.</param>
-                /// <returns>An object that contains information about the match.</returns>
-                /// <exception cref="System::ArgumentNullException">
-                ///     <paramref name="input"/> is <c>null</c>.
-                /// </exception>
-                /// <exception cref="System::ArgumentOutOfRangeException">
-                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
-                ///     <para>- or -</para>
-                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
-                ///     <para>- or -</para>
-                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
-                /// </exception>
-                _Match^ Match(String^ input, int startIndex);
-                
-
-                /// <summary>
-                ///     Searches the input byte array for the first occurrence of a regular expression, beginning at the specified starting
-                ///     position.
-                /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
-                /// <param name="startIndex">The input index at which to start the search.</param>
-                /// <returns>An object that contains information about the match.</returns>
-                /// <exception cref="System::ArgumentNullException">
-                ///     <paramref name="input"/> is <c>null</c>.
-                /// </exception>
-                /// <exception cref="System::ArgumentOutOfRangeException">
-                ///     <paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.
-                /// </exception>
-                _Match^ Match(array<Byte>^ input, int startIndex);
+                bool FullMatch(array<Byte>^ input, int startIndex, int length);
 
 
                 /// <summary>
-                ///     Searches the input string for the first occurrence of a regular expression.
+                ///     Indicates whether the regular expression specified in the <c>Regex</c> constructor matches the entire the specified
+                ///     input string.
                 /// </summary>
-                /// <param name="input">The string to search for a match.</param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <param name="input">The string to match.</param>
+                /// <returns><c>true</c> if the regular expression matches the entire <paramref name="input"/>; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> is <c>null</c>.
                 /// </exception>
@@ -548,30 +826,32 @@ namespace Net
                 ///     <para>- or -</para>
                 ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                _Match^ Match(String^ input);
+                bool FullMatch(String^ input);
 
 
                 /// <summary>
-                ///     Searches the input byte array for the first occurrence of a regular expression.
+                ///     Indicates whether the regular expression specified in the <c>Regex</c> constructor matches the entire the specified
+                ///     input byte array.
                 /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <param name="input">The byte array to match.</param>
+                /// <returns><c>true</c> if the regular expression matches the entire <paramref name="input"/>; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> is <c>null</c>.
                 /// </exception>
-                _Match^ Match(array<Byte>^ input);
+                bool FullMatch(array<Byte>^ input);
 
 
                 /// <summary>
-                ///     Searches the input string for the first occurrence of the specified regular expression, using the specified matching options.
+                ///     Indicates whether the specified regular expression matches the entire the specified input string, using the
+                ///     specified matching options.
                 /// </summary>
-                /// <param name="input">The string to search for a match.</param>
+                /// <param name="input">The string to match.</param>
                 /// <param name="pattern">
                 ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
                 ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
                 /// </param>
-                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <param name="options">A bitwise combination of the enumeration values that modify the regular expression.</param>
+                /// <returns><c>true</c> if the regular expression matches the entire <paramref name="input"/>; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentException">
                 ///     A regular expression parsing error occurred.
                 /// </exception>
@@ -585,19 +865,20 @@ namespace Net
                 ///     <para>- or -</para>
                 ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                static _Match^ Match(String^ input, String^ pattern, RegexOptions options);
+                static bool FullMatch(String^ input, String^ pattern, RegexOptions options);
 
 
                 /// <summary>
-                ///     Searches the input byte array for the first occurrence of the specified regular expression, using the specified matching options.
+                ///     Indicates whether the specified regular expression matches the entire the specified input byte array, using the
+                ///     specified matching options.
                 /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="input">The byte array to match.</param>
                 /// <param name="pattern">
                 ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
                 ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
                 /// </param>
-                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <param name="options">A bitwise combination of the enumeration values that modify the regular expression.</param>
+                /// <returns><c>true</c> if the regular expression matches the entire <paramref name="input"/>; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentException">
                 ///     A regular expression parsing error occurred.
                 /// </exception>
@@ -611,239 +892,1752 @@ namespace Net
                 ///     <para>- or -</para>
                 ///     <para><paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                static _Match^ Match(array<Byte>^ input, String^ pattern, RegexOptions options);
+                static bool FullMatch(array<Byte>^ input, String^ pattern, RegexOptions options);
 
 
                 /// <summary>
-                ///     Searches the input string for the first occurrence of the specified regular expression.
+                ///     Indicates whether the specified regular expression matches the entire the specified input string.
                 /// </summary>
-                /// <param name="input">The string to search for a match.</param>
+                /// <param name="input">The string to match.</param>
                 /// <param name="pattern">
                 ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
                 ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
                 /// </param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <returns><c>true</c> if the regular expression matches the entire <paramref name="input"/>; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentException">
                 ///     A regular expression parsing error occurred.
                 /// </exception>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
                 /// </exception>
-                /// <exception cref="System::ArgumentOutOfRangeException">
-                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
-                ///     <para>- or -</para>
-                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
-                /// </exception>
-                static _Match^ Match(String^ input, String^ pattern);
+                static bool FullMatch(String^ input, String^ pattern);
                 /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
 
 
                 /// <summary>
-                ///     Searches the input byte array for the first occurrence of the specified regular expression.
+                ///     Indicates whether the specified regular expression matches the entire the specified input byte array.
                 /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="input">The byte array to match.</param>
                 /// <param name="pattern">
                 ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
                 ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
                 /// </param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <returns><c>true</c> if the regular expression matches the entire <paramref name="input"/>; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentException">
                 ///     A regular expression parsing error occurred.
                 /// </exception>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
                 /// </exception>
-                static _Match^ Match(array<Byte>^ input, String^ pattern);
+                static bool FullMatch(array<Byte>^ input, String^ pattern);
                 /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
 
-            #pragma endregion
-
-
-            #pragma region Matches
 
                 /// <summary>
-                ///     Searches the specified input string for all occurrences of a regular expression, beginning at the specified
-                ///     starting position in the string.
+                ///     Indicates whether the regular expression specified in the <c>Regex</c> constructor matches a prefix of the specified
+                ///     substring of the input string.
                 /// </summary>
-                /// <param name="input">The string to search for a match.</param>
-                /// <param name="startIndex">The input index at which to start the search.</param>
-                /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
-                /// </returns>
+                /// <param name="input">The string to match.</param>
+                /// <param name="startIndex">The input index at which the substring begins.</param>
+                /// <param name="length">The number of characters in the substring.</param>
+                /// <returns><c>true</c> if the regular expression matches a prefix of the substring; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> is <c>null</c>.
                 /// </exception>
                 /// <exception cref="System::ArgumentOutOfRangeException">
                 ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
                 ///     <para>- or -</para>
+                ///     <para><paramref name="length"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><c><paramref name="startIndex"/> + <paramref name="length"/>  1</c> identifies a position that is outside the range of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
                 ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
                 ///     <para>- or -</para>
                 ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                MatchCollection^ Matches(String^ input, int startIndex);
+                bool PrefixMatch(String^ input, int startIndex, int length);
 
 
                 /// <summary>
-                ///     Searches the specified input byte array for all occurrences of a regular expression, beginning at the specified
-                ///     starting position.
+                ///     Indicates whether the regular expression specified in the <c>Regex</c> constructor matches a prefix of the specified
+                ///     range of the input byte array.
                 /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
-                /// <param name="startIndex">The input index at which to start the search.</param>
-                /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
-                /// </returns>
+                /// <param name="input">The byte array to match.</param>
+                /// <param name="startIndex">The input index at which the range begins.</param>
+                /// <param name="length">The number of bytes in the range.</param>
+                /// <returns><c>true</c> if the regular expression matches a prefix of the range; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> is <c>null</c>.
                 /// </exception>
                 /// <exception cref="System::ArgumentOutOfRangeException">
-                ///     <paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.
-                /// </exception>
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="length"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><c><paramref name="startIndex"/> + <paramref name="length"/>  1</c> identifies a position that is outside the range of <paramref name="input"/>.</para>
+                /// </exception>
+                bool PrefixMatch(array<Byte>^ input, int startIndex, int length);
+
+
+                /// <summary>
+                ///     Indicates whether the regular expression specified in the <c>Regex</c> constructor matches a prefix of the specified
+                ///     input string.
+                /// </summary>
+                /// <param name="input">The string to match.</param>
+                /// <returns><c>true</c> if the regular expression matches a prefix of <paramref name="input"/>; otherwise, <c>false</c>.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                bool PrefixMatch(String^ input);
+
+
+                /// <summary>
+                ///     Indicates whether the regular expression specified in the <c>Regex</c> constructor matches a prefix of the specified
+                ///     input byte array.
+                /// </summary>
+                /// <param name="input">The byte array to match.</param>
+                /// <returns><c>true</c> if the regular expression matches a prefix of <paramref name="input"/>; otherwise, <c>false</c>.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                bool PrefixMatch(array<Byte>^ input);
+
+
+                /// <summary>
+                ///     Indicates whether the specified regular expression matches a prefix of the specified input string, using the
+                ///     specified matching options.
+                /// </summary>
+                /// <param name="input">The string to match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <param name="options">A bitwise combination of the enumeration values that modify the regular expression.</param>
+                /// <returns><c>true</c> if the regular expression matches a prefix of <paramref name="input"/>; otherwise, <c>false</c>.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="options"/> is not a valid <c>RegexOptions</c> value.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static bool PrefixMatch(String^ input, String^ pattern, RegexOptions options);
+
+
+                /// <summary>
+                ///     Indicates whether the specified regular expression matches a prefix of the specified input byte array, using the
+                ///     specified matching options.
+                /// </summary>
+                /// <param name="input">The byte array to match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <param name="options">A bitwise combination of the enumeration values that modify the regular expression.</param>
+                /// <returns><c>true</c> if the regular expression matches a prefix of <paramref name="input"/>; otherwise, <c>false</c>.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="options"/> is not a valid <c>RegexOptions</c> value.
+                ///     <para>- or -</para>
+                ///     <para><paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static bool PrefixMatch(array<Byte>^ input, String^ pattern, RegexOptions options);
+
+
+                /// <summary>
+                ///     Indicates whether the specified regular expression matches a prefix of the specified input string.
+                /// </summary>
+                /// <param name="input">The string to match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <returns><c>true</c> if the regular expression matches a prefix of <paramref name="input"/>; otherwise, <c>false</c>.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                static bool PrefixMatch(String^ input, String^ pattern);
+                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+
+
+                /// <summary>
+                ///     Indicates whether the specified regular expression matches a prefix of the specified input byte array.
+                /// </summary>
+                /// <param name="input">The byte array to match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <returns><c>true</c> if the regular expression matches a prefix of <paramref name="input"/>; otherwise, <c>false</c>.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                static bool PrefixMatch(array<Byte>^ input, String^ pattern);
+                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+
+            #pragma endregion
+
+
+            #pragma region Match
+
+            internal:
+
+                /*
+                 *  groupMask : Bit i selects group i, or -1 selects every group. RE2 is only asked for groups
+                 *              up to the highest one selected, and groups below it that aren't selected are
+                 *              left as Group::Empty. The whole match is always captured. Match::NextMatch()
+                 *              carries the mask on to the next match.
+                 */
+                _Match^ _match(RegexInput^ input, int startIndex, int length, int stringStartIndex);
+                _Match^ _match(RegexInput^ input, int startIndex, int length, int stringStartIndex, Int64 groupMask);
+                _Match^ _match(String^ input, int startIndex, int length, Int64 groupMask);
+                _Match^ _match(array<Byte>^ input, int startIndex, int length, Int64 groupMask);
+
+                /*
+                 *  _match() split into its two halves, so that callers holding the input in a scratch
+                 *  buffer (see Batch) only pay for a RegexInput when the search actually succeeds.
+                 *
+                 *  _search : Runs RE2 over data, filling captures with up to groupCount submatches.
+                 *            Timed for RegexOptions::Telemetry; _find does the work. The array
+                 *            overload pins the array, which may be empty, for the search only.
+                 *
+                 *  _create : Builds a Match from captures. base is the buffer the captures point into,
+                 *            which need not be input->Data, so long as it holds the same bytes.
+                 */
+                bool    _search(const char* data, int size, int startIndex, int endIndex, StringPiece* captures, int groupCount);
+                bool    _search(const char* data, int size, int startIndex, int endIndex, StringPiece* captures, int groupCount, RE2::Anchor anchor);
+                bool    _search(array<Byte>^ input, int startIndex, int endIndex, StringPiece* captures, int groupCount, RE2::Anchor anchor);
+                bool    _find(const char* data, int size, int startIndex, int endIndex, StringPiece* captures, int groupCount, RE2::Anchor anchor);
+                _Match^ _create(RegexInput^ input, const char* base, StringPiece* captures, int groupCount, int startIndex, int stringStartIndex);
+                _Match^ _create(RegexInput^ input, const char* base, StringPiece* captures, int groupCount, int startIndex, int stringStartIndex, Int64 groupMask);
+
+                int     _groupCount();
+                int     _groupCount(Int64 groupMask);
+
+                /* Converts input to the encoding selected by options, in a RegexInput that owns the result. */
+                static RegexInput^ _convert(String^ input, String^ argument, RegexOptions options);
+
+
+            public:
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of a regular expression, beginning at the specified starting
+                ///     position and searching only the specified number of characters.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <param name="length">The number of characters in the substring to include in the search.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="length"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><c><paramref name="startIndex"/> + <paramref name="length"/>  1</c> identifies a position that is outside the range of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                _Match^ Match(String^ input, int startIndex, int length);
+                
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of a regular expression, beginning at the specified starting
+                ///     position and searching only the specified number of bytes.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <param name="length">The number of bytes in the input to include in the search.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="length"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><c><paramref name="startIndex"/> + <paramref name="length"/>  1</c> identifies a position that is outside the range of <paramref name="input"/>.</para>
+                /// </exception>
+                _Match^ Match(array<Byte>^ input, int startIndex, int length);
+                
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of a regular expression, beginning at the specified starting
+                ///     position in the string.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="startIndex">The zero-based input index at which to start the search.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                _Match^ Match(String^ input, int startIndex);
+                
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of a regular expression, beginning at the specified starting
+                ///     position.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.
+                /// </exception>
+                _Match^ Match(array<Byte>^ input, int startIndex);
+
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of a regular expression.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                _Match^ Match(String^ input);
+
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of a regular expression.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                _Match^ Match(array<Byte>^ input);
+
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of a regular expression, capturing only the first
+                ///     <paramref name="maxGroups"/> groups.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="maxGroups">
+                ///     The number of groups to capture, not counting group 0, the entire match, which is always captured.
+                /// </param>
+                /// <returns>
+                ///     An object that contains information about the match. Its <c>Groups</c> only include the groups captured.
+                /// </returns>
+                /// <remarks>
+                ///     RE2 finds the bounds of the entire match with its DFA, and only runs a slower engine for as many groups as it
+                ///     is asked for. With a <paramref name="maxGroups"/> of 0, one <c>Regex</c> serves call sites that only need the
+                ///     match as fast as one created with <c>RegexOptions.SingleCapture</c>. <c>NextMatch</c> captures the same groups.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="maxGroups"/> is less than zero.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                _Match^ MatchGroups(String^ input, int maxGroups);
+
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of a regular expression, capturing only the first
+                ///     <paramref name="maxGroups"/> groups.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="maxGroups">
+                ///     The number of groups to capture, not counting group 0, the entire match, which is always captured.
+                /// </param>
+                /// <returns>
+                ///     An object that contains information about the match. Its <c>Groups</c> only include the groups captured.
+                /// </returns>
+                /// <remarks>
+                ///     See <see cref="MatchGroups(String^, int)"/>.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="maxGroups"/> is less than zero.
+                /// </exception>
+                _Match^ MatchGroups(array<Byte>^ input, int maxGroups);
+
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of the specified regular expression, using the specified matching options.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="options"/> is not a valid <c>RegexOptions</c> value.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static _Match^ Match(String^ input, String^ pattern, RegexOptions options);
+
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of the specified regular expression, using the specified matching options.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="options"/> is not a valid <c>RegexOptions</c> value.
+                ///     <para>- or -</para>
+                ///     <para><paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static _Match^ Match(array<Byte>^ input, String^ pattern, RegexOptions options);
+
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of the specified regular expression.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static _Match^ Match(String^ input, String^ pattern);
+                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of the specified regular expression.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                static _Match^ Match(array<Byte>^ input, String^ pattern);
+                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+
+            #pragma endregion
+
+
+            #pragma region Matches
+
+                /// <summary>
+                ///     Searches the specified input string for all occurrences of a regular expression, beginning at the specified
+                ///     starting position in the string.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                MatchCollection^ Matches(String^ input, int startIndex);
+
+
+                /// <summary>
+                ///     Searches the specified input byte array for all occurrences of a regular expression, beginning at the specified
+                ///     starting position.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.
+                /// </exception>
                 MatchCollection^ Matches(array<Byte>^ input, int startIndex);
 
 
                 /// <summary>
-                ///     Searches the specified input string for all occurrences of a regular expression.
+                ///     Searches the specified input string for all occurrences of a regular expression.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                MatchCollection^ Matches(String^ input);
+
+
+                /// <summary>
+                ///     Searches the specified input byte array for all occurrences of a regular expression.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                MatchCollection^ Matches(array<Byte>^ input);
+
+
+                /// <summary>
+                ///     Searches the specified input string for all occurrences of a regular expression, capturing only the groups
+                ///     selected by <paramref name="groupMask"/>.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="groupMask">
+                ///     A bit mask of the groups to capture: bit 1 for group 1, bit 2 for group 2, and so on. Group 0, the entire
+                ///     match, is always captured. -1 captures every group, including any after group 63.
+                /// </param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <remarks>
+                ///     RE2 is only asked for the groups up to the highest one selected. Groups below it that aren't selected are
+                ///     left unsuccessful, so their positions are never translated and no <c>Group</c> objects are created for them.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                MatchCollection^ MatchesGroups(String^ input, Int64 groupMask);
+
+
+                /// <summary>
+                ///     Searches the specified input byte array for all occurrences of a regular expression, capturing only the groups
+                ///     selected by <paramref name="groupMask"/>.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="groupMask">
+                ///     A bit mask of the groups to capture: bit 1 for group 1, bit 2 for group 2, and so on. Group 0, the entire
+                ///     match, is always captured. -1 captures every group, including any after group 63.
+                /// </param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <remarks>
+                ///     See <see cref="MatchesGroups(String^, Int64)"/>.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                MatchCollection^ MatchesGroups(array<Byte>^ input, Int64 groupMask);
+
+
+                /// <summary>
+                ///     Searches the specified input string for all occurrences of the specified regular expression, using the
+                ///     specified matching options.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="options"/> is not a valid <c>RegexOptions</c> value.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static MatchCollection^ Matches(String^ input, String^ pattern, RegexOptions options);
+
+
+                /// <summary>
+                ///     Searches the specified input byte array for all occurrences of the specified regular expression, using the
+                ///     specified matching options.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="options"/> is not a valid <c>RegexOptions</c> value.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static MatchCollection^ Matches(array<Byte>^ input, String^ pattern, RegexOptions options);
+
+
+                /// <summary>
+                ///     Searches the specified input string for all occurrences of the specified regular expression.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                static MatchCollection^ Matches(String^ input, String^ pattern);
+                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+
+
+                /// <summary>
+                ///     Searches the specified input byte array for all occurrences of the specified regular expression.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                static MatchCollection^ Matches(array<Byte>^ input, String^ pattern);
+                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+
+            #pragma endregion
+
+
+            #pragma region Typed extraction
+
+            private:
+
+                template <typename T>
+                bool _extract(const char* data, int size, array<T>^ values, NumberBase numberBase);
+
+                template <typename T>
+                bool _extract(String^ input, array<T>^ values, NumberBase numberBase);
+
+                template <typename T>
+                bool _extract(array<Byte>^ input, array<T>^ values, NumberBase numberBase);
+
+
+            public:
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of a regular expression and reads its captured groups as
+                ///     32-bit integers.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="values">
+                ///     The array that receives the values. Element <c>i</c> receives group <c>i + 1</c>; groups after the last element
+                ///     are ignored.
+                /// </param>
+                /// <returns>
+                ///     <c>true</c> if the regular expression finds a match and every group read parses as a number; otherwise, <c>false</c>.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="values"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="values"/> has more elements than the regular expression has capturing groups.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                /// <remarks>
+                ///     Captures are parsed by RE2 straight from the matched text, without creating a <c>Match</c> or any strings. A group
+                ///     that didn't participate in the match reads as empty, which isn't a number. If the method returns <c>false</c>,
+                ///     <paramref name="values"/> may have been partly overwritten.
+                /// </remarks>
+                bool TryExtract(String^ input, array<Int32>^ values);
+
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of a regular expression and reads its captured groups as
+                ///     32-bit integers.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="values">
+                ///     The array that receives the values. Element <c>i</c> receives group <c>i + 1</c>; groups after the last element
+                ///     are ignored.
+                /// </param>
+                /// <returns>
+                ///     <c>true</c> if the regular expression finds a match and every group read parses as a number; otherwise, <c>false</c>.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="values"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="values"/> has more elements than the regular expression has capturing groups.
+                /// </exception>
+                /// <remarks>
+                ///     Captures are parsed by RE2 straight from the matched text, without creating a <c>Match</c> or any strings. A group
+                ///     that didn't participate in the match reads as empty, which isn't a number. If the method returns <c>false</c>,
+                ///     <paramref name="values"/> may have been partly overwritten.
+                /// </remarks>
+                bool TryExtract(array<Byte>^ input, array<Int32>^ values);
+
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of a regular expression and reads its captured groups as
+                ///     32-bit integers, in the specified base.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="values">
+                ///     The array that receives the values. Element <c>i</c> receives group <c>i + 1</c>; groups after the last element
+                ///     are ignored.
+                /// </param>
+                /// <param name="numberBase">The base in which the captured integers are written.</param>
+                /// <returns>
+                ///     <c>true</c> if the regular expression finds a match and every group read parses as a number; otherwise, <c>false</c>.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="values"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="values"/> has more elements than the regular expression has capturing groups.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="numberBase"/> is not a valid <c>NumberBase</c> value.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                /// <remarks>
+                ///     Captures are parsed by RE2 straight from the matched text, without creating a <c>Match</c> or any strings. A group
+                ///     that didn't participate in the match reads as empty, which isn't a number. If the method returns <c>false</c>,
+                ///     <paramref name="values"/> may have been partly overwritten.
+                /// </remarks>
+                bool TryExtract(String^ input, array<Int32>^ values, NumberBase numberBase);
+
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of a regular expression and reads its captured groups as
+                ///     32-bit integers, in the specified base.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="values">
+                ///     The array that receives the values. Element <c>i</c> receives group <c>i + 1</c>; groups after the last element
+                ///     are ignored.
+                /// </param>
+                /// <param name="numberBase">The base in which the captured integers are written.</param>
+                /// <returns>
+                ///     <c>true</c> if the regular expression finds a match and every group read parses as a number; otherwise, <c>false</c>.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="values"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="values"/> has more elements than the regular expression has capturing groups.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="numberBase"/> is not a valid <c>NumberBase</c> value.
+                /// </exception>
+                /// <remarks>
+                ///     Captures are parsed by RE2 straight from the matched text, without creating a <c>Match</c> or any strings. A group
+                ///     that didn't participate in the match reads as empty, which isn't a number. If the method returns <c>false</c>,
+                ///     <paramref name="values"/> may have been partly overwritten.
+                /// </remarks>
+                bool TryExtract(array<Byte>^ input, array<Int32>^ values, NumberBase numberBase);
+
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of a regular expression and reads its captured groups as
+                ///     64-bit integers.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="values">
+                ///     The array that receives the values. Element <c>i</c> receives group <c>i + 1</c>; groups after the last element
+                ///     are ignored.
+                /// </param>
+                /// <returns>
+                ///     <c>true</c> if the regular expression finds a match and every group read parses as a number; otherwise, <c>false</c>.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="values"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="values"/> has more elements than the regular expression has capturing groups.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                /// <remarks>
+                ///     Captures are parsed by RE2 straight from the matched text, without creating a <c>Match</c> or any strings. A group
+                ///     that didn't participate in the match reads as empty, which isn't a number. If the method returns <c>false</c>,
+                ///     <paramref name="values"/> may have been partly overwritten.
+                /// </remarks>
+                bool TryExtract(String^ input, array<Int64>^ values);
+
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of a regular expression and reads its captured groups as
+                ///     64-bit integers.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="values">
+                ///     The array that receives the values. Element <c>i</c> receives group <c>i + 1</c>; groups after the last element
+                ///     are ignored.
+                /// </param>
+                /// <returns>
+                ///     <c>true</c> if the regular expression finds a match and every group read parses as a number; otherwise, <c>false</c>.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="values"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="values"/> has more elements than the regular expression has capturing groups.
+                /// </exception>
+                /// <remarks>
+                ///     Captures are parsed by RE2 straight from the matched text, without creating a <c>Match</c> or any strings. A group
+                ///     that didn't participate in the match reads as empty, which isn't a number. If the method returns <c>false</c>,
+                ///     <paramref name="values"/> may have been partly overwritten.
+                /// </remarks>
+                bool TryExtract(array<Byte>^ input, array<Int64>^ values);
+
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of a regular expression and reads its captured groups as
+                ///     64-bit integers, in the specified base.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="values">
+                ///     The array that receives the values. Element <c>i</c> receives group <c>i + 1</c>; groups after the last element
+                ///     are ignored.
+                /// </param>
+                /// <param name="numberBase">The base in which the captured integers are written.</param>
+                /// <returns>
+                ///     <c>true</c> if the regular expression finds a match and every group read parses as a number; otherwise, <c>false</c>.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="values"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="values"/> has more elements than the regular expression has capturing groups.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="numberBase"/> is not a valid <c>NumberBase</c> value.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                /// <remarks>
+                ///     Captures are parsed by RE2 straight from the matched text, without creating a <c>Match</c> or any strings. A group
+                ///     that didn't participate in the match reads as empty, which isn't a number. If the method returns <c>false</c>,
+                ///     <paramref name="values"/> may have been partly overwritten.
+                /// </remarks>
+                bool TryExtract(String^ input, array<Int64>^ values, NumberBase numberBase);
+
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of a regular expression and reads its captured groups as
+                ///     64-bit integers, in the specified base.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="values">
+                ///     The array that receives the values. Element <c>i</c> receives group <c>i + 1</c>; groups after the last element
+                ///     are ignored.
+                /// </param>
+                /// <param name="numberBase">The base in which the captured integers are written.</param>
+                /// <returns>
+                ///     <c>true</c> if the regular expression finds a match and every group read parses as a number; otherwise, <c>false</c>.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="values"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="values"/> has more elements than the regular expression has capturing groups.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="numberBase"/> is not a valid <c>NumberBase</c> value.
+                /// </exception>
+                /// <remarks>
+                ///     Captures are parsed by RE2 straight from the matched text, without creating a <c>Match</c> or any strings. A group
+                ///     that didn't participate in the match reads as empty, which isn't a number. If the method returns <c>false</c>,
+                ///     <paramref name="values"/> may have been partly overwritten.
+                /// </remarks>
+                bool TryExtract(array<Byte>^ input, array<Int64>^ values, NumberBase numberBase);
+
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of a regular expression and reads its captured groups as
+                ///     double-precision floating-point numbers.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="values">
+                ///     The array that receives the values. Element <c>i</c> receives group <c>i + 1</c>; groups after the last element
+                ///     are ignored.
+                /// </param>
+                /// <returns>
+                ///     <c>true</c> if the regular expression finds a match and every group read parses as a number; otherwise, <c>false</c>.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="values"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="values"/> has more elements than the regular expression has capturing groups.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                /// <remarks>
+                ///     Captures are parsed by RE2 straight from the matched text, without creating a <c>Match</c> or any strings. A group
+                ///     that didn't participate in the match reads as empty, which isn't a number. If the method returns <c>false</c>,
+                ///     <paramref name="values"/> may have been partly overwritten.
+                /// </remarks>
+                bool TryExtract(String^ input, array<Double>^ values);
+
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of a regular expression and reads its captured groups as
+                ///     double-precision floating-point numbers.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="values">
+                ///     The array that receives the values. Element <c>i</c> receives group <c>i + 1</c>; groups after the last element
+                ///     are ignored.
+                /// </param>
+                /// <returns>
+                ///     <c>true</c> if the regular expression finds a match and every group read parses as a number; otherwise, <c>false</c>.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="values"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="values"/> has more elements than the regular expression has capturing groups.
+                /// </exception>
+                /// <remarks>
+                ///     Captures are parsed by RE2 straight from the matched text, without creating a <c>Match</c> or any strings. A group
+                ///     that didn't participate in the match reads as empty, which isn't a number. If the method returns <c>false</c>,
+                ///     <paramref name="values"/> may have been partly overwritten.
+                /// </remarks>
+                bool TryExtract(array<Byte>^ input, array<Double>^ values);
+
+            #pragma endregion
+
+
+            #pragma region Sorted key ranges
+
+            private:
+
+                /*
+                 *  The maximum length of the bounds FullMatchSorted() asks RE2 for. Longer bounds narrow
+                 *  the range only for patterns with longer literal prefixes, and cost a longer DFA walk.
+                 */
+                static const int SORTED_RANGE_LENGTH = 32;
+
+
+            public:
+
+                /// <summary>
+                ///     Computes the lowest and highest strings that the regular expression can match in full.
+                /// </summary>
+                /// <param name="maxLength">The maximum number of bytes in either bound.</param>
+                /// <param name="min">
+                ///     When this method returns, the lower bound, in the encoding of the expression. This parameter is passed
+                ///     uninitialized.
+                /// </param>
+                /// <param name="max">
+                ///     When this method returns, the upper bound, in the encoding of the expression. This parameter is passed
+                ///     uninitialized.
+                /// </param>
+                /// <returns>
+                ///     <c>true</c> if the bounds could be computed; otherwise, <c>false</c>, in which case both bounds are empty.
+                /// </returns>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="maxLength"/> is less than zero.
+                /// </exception>
+                /// <remarks>
+                ///     <para>
+                ///         Every input <c>s</c> for which <see cref="FullMatch(array{Byte}^)"/> returns <c>true</c> satisfies
+                ///         <c>min &lt;= s &lt;= max</c>, comparing bytes as unsigned values. A bound that would be longer than
+                ///         <paramref name="maxLength"/> is truncated, and the upper bound is then rounded up, so it may be an
+                ///         invalid UTF-8 sequence. An empty upper bound after a successful call means there is no upper bound.
+                ///     </para>
+                ///     <para>
+                ///         Only the first copy of an element repeated by '*' or '+' is considered, so the bounds of an expression
+                ///         such as <c>.*abc</c> are too wide to be of use. The call fails if every string matches.
+                ///     </para>
+                /// </remarks>
+                bool PossibleMatchRange(int maxLength, [Out] array<Byte>^% min, [Out] array<Byte>^% max);
+
+
+                /// <summary>
+                ///     Finds the keys of a sorted list that the regular expression matches in full, testing only the keys that lie
+                ///     within the range returned by <see cref="PossibleMatchRange"/>.
+                /// </summary>
+                /// <param name="sortedKeys">The keys to match, in ascending order.</param>
+                /// <returns>
+                ///     The indices, in ascending order, of the keys for which <see cref="FullMatch(String^)"/> returns <c>true</c>.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <para><paramref name="sortedKeys"/> is <c>null</c>.</para>
+                ///     <para>- or -</para>
+                ///     <para>An element of <paramref name="sortedKeys"/> is <c>null</c>.</para>
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para>A key in range is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para>A key in range is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                /// <remarks>
+                ///     <para>
+                ///         The range is found by binary search, so a pattern with a literal prefix, such as <c>user:42:.*</c>, only
+                ///         costs a match per key that shares the prefix. If no range can be computed, every key is tested.
+                ///     </para>
+                ///     <para>
+                ///         Keys must be sorted as by <c>String.CompareOrdinal</c>. In Unicode mode they must in fact be sorted by
+                ///         code point, which differs only in that a character from U+E000 to U+FFFF sorts before a surrogate pair
+                ///         rather than after it. An unsorted list gives undefined results.
+                ///     </para>
+                /// </remarks>
+                array<int>^ FullMatchSorted(IList<String^>^ sortedKeys);
+
+
+                /// <summary>
+                ///     Finds the keys of a sorted list that the regular expression matches in full, testing only the keys that lie
+                ///     within the range returned by <see cref="PossibleMatchRange"/>.
+                /// </summary>
+                /// <param name="sortedKeys">The keys to match, in ascending order.</param>
+                /// <returns>
+                ///     The indices, in ascending order, of the keys for which <see cref="FullMatch(array{Byte}^)"/> returns <c>true</c>.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <para><paramref name="sortedKeys"/> is <c>null</c>.</para>
+                ///     <para>- or -</para>
+                ///     <para>An element of <paramref name="sortedKeys"/> is <c>null</c>.</para>
+                /// </exception>
+                /// <remarks>
+                ///     Keys must be sorted by comparing bytes as unsigned values, with a key that is a prefix of another sorting
+                ///     first. An unsorted list gives undefined results.
+                /// </remarks>
+                array<int>^ FullMatchSorted(IList<array<Byte>^>^ sortedKeys);
+
+            #pragma endregion
+
+
+            #pragma region Unmanaged and segmented input
+
+            /*
+             *  Memory passed by IntPtr is borrowed, not copied: Regex reads it during the call, and the
+             *  resulting Match reads it again for NextMatch() and Capture.Value. ArraySegment input
+             *  behaves like a byte array, with indices relative to the start of the segment.
+             */
+
+            public:
+
+                /// <summary>
+                ///     Indicates whether the regular expression specified in the <c>Regex</c> constructor finds a match in the specified
+                ///     block of unmanaged memory.
+                /// </summary>
+                /// <param name="data">A pointer to the first byte to search.</param>
+                /// <param name="length">The number of bytes to search.</param>
+                /// <returns><c>true</c> if the regular expression finds a match; otherwise, <c>false</c>.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="data"/> is <c>IntPtr.Zero</c> and <paramref name="length"/> is greater than zero.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="length"/> is less than zero or greater than <c>Int32.MaxValue</c>.
+                /// </exception>
+                /// <remarks>
+                ///     The memory is read in place and must remain valid for the duration of the call.
+                /// </remarks>
+                bool IsMatch(IntPtr data, Int64 length);
+
+
+                /// <summary>
+                ///     Indicates whether the regular expression specified in the <c>Regex</c> constructor finds a match in the specified
+                ///     byte array segment.
+                /// </summary>
+                /// <param name="input">The byte array segment to search for a match.</param>
+                /// <returns><c>true</c> if the regular expression finds a match; otherwise, <c>false</c>.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     The array of <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                bool IsMatch(ArraySegment<Byte> input);
+
+
+                /// <summary>
+                ///     Searches the specified block of unmanaged memory for the first occurrence of a regular expression.
+                /// </summary>
+                /// <param name="data">A pointer to the first byte to search.</param>
+                /// <param name="length">The number of bytes to search.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="data"/> is <c>IntPtr.Zero</c> and <paramref name="length"/> is greater than zero.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="length"/> is less than zero or greater than <c>Int32.MaxValue</c>.
+                /// </exception>
+                /// <remarks>
+                ///     The memory is not copied. It must remain valid and unchanged for as long as the returned <c>Match</c>, or
+                ///     any <c>Group</c> or <c>Capture</c> obtained from it, is in use: <c>NextMatch</c> searches it again, and
+                ///     <c>Capture.Value</c> decodes from it. <c>Capture.Index</c> and <c>Capture.Length</c> are byte offsets from
+                ///     <paramref name="data"/>.
+                /// </remarks>
+                _Match^ Match(IntPtr data, Int64 length);
+
+
+                /// <summary>
+                ///     Searches the specified byte array segment for the first occurrence of a regular expression.
                 /// </summary>
-                /// <param name="input">The string to search for a match.</param>
+                /// <param name="input">The byte array segment to search for a match.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     The array of <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <remarks>
+                ///     <c>Capture.Index</c> is relative to the offset of <paramref name="input"/>, not to the start of the array.
+                /// </remarks>
+                _Match^ Match(ArraySegment<Byte> input);
+
+
+                /// <summary>
+                ///     Searches the specified block of unmanaged memory for all occurrences of a regular expression.
+                /// </summary>
+                /// <param name="data">A pointer to the first byte to search.</param>
+                /// <param name="length">The number of bytes to search.</param>
                 /// <returns>
                 ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
                 ///     returns an empty collection object.
                 /// </returns>
                 /// <exception cref="System::ArgumentNullException">
-                ///     <paramref name="input"/> is <c>null</c>.
+                ///     <paramref name="data"/> is <c>IntPtr.Zero</c> and <paramref name="length"/> is greater than zero.
                 /// </exception>
                 /// <exception cref="System::ArgumentOutOfRangeException">
-                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
-                ///     <para>- or -</para>
-                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                ///     <paramref name="length"/> is less than zero or greater than <c>Int32.MaxValue</c>.
                 /// </exception>
-                MatchCollection^ Matches(String^ input);
+                /// <remarks>
+                ///     The collection is evaluated lazily, so the memory must remain valid and unchanged until the collection and
+                ///     every <c>Match</c> in it are no longer in use.
+                /// </remarks>
+                MatchCollection^ Matches(IntPtr data, Int64 length);
 
 
                 /// <summary>
-                ///     Searches the specified input byte array for all occurrences of a regular expression.
+                ///     Searches the specified byte array segment for all occurrences of a regular expression.
                 /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="input">The byte array segment to search for a match.</param>
                 /// <returns>
                 ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
                 ///     returns an empty collection object.
                 /// </returns>
                 /// <exception cref="System::ArgumentNullException">
-                ///     <paramref name="input"/> is <c>null</c>.
+                ///     The array of <paramref name="input"/> is <c>null</c>.
                 /// </exception>
-                MatchCollection^ Matches(array<Byte>^ input);
+                MatchCollection^ Matches(ArraySegment<Byte> input);
+
+            #pragma endregion
+
+
+            #pragma region Batch matching
+
+            private:
+
+                /*
+                 *  Applies the Regex to every element of an input list in parallel. The list is cut
+                 *  into ranges that the thread pool's workers take as they become free (and steal
+                 *  from one another), so a few long records don't hold up the rest of the batch.
+                 *
+                 *  Each worker owns a native conversion buffer for the life of the loop, so String
+                 *  inputs are transcoded without a malloc() per record. A RegexInput, which has to
+                 *  own a copy of the converted input, is only created for records that match.
+                 */
+                ref class Batch sealed
+                {
+                    private:
+
+                        Regex^               _regex;
+                        IList<String^>^      _strings;
+                        IList<array<Byte>^>^ _bytes;
+                        array<bool>^         _isMatch;
+                        array<_Match^>^      _matches;
+
+                        IntPtr Init();
+                        IntPtr Body(Tuple<int, int>^ range, ParallelLoopState^ state, IntPtr buffer);
+                        void   Finally(IntPtr buffer);
+
+
+                    internal:
 
+                        /* Exactly one of strings and bytes, and exactly one of isMatch and matches, are non-null. */
+                        Batch(Regex^ regex, IList<String^>^ strings, IList<array<Byte>^>^ bytes, array<bool>^ isMatch, array<_Match^>^ matches);
+
+                        void Run(int count, int maxDegreeOfParallelism);
+                };
+
+
+            public:
 
                 /// <summary>
-                ///     Searches the specified input string for all occurrences of the specified regular expression, using the
-                ///     specified matching options.
+                ///     Indicates, for each string in the specified list, whether the regular expression specified in the <c>Regex</c>
+                ///     constructor finds a match in it, using up to the specified number of threads.
                 /// </summary>
-                /// <param name="input">The string to search for a match.</param>
-                /// <param name="pattern">
-                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
-                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
-                /// </param>
-                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
+                /// <param name="inputs">The strings to search for a match.</param>
+                /// <param name="maxDegreeOfParallelism">The maximum number of concurrent threads, or -1 for no limit.</param>
                 /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
+                ///     An array of the same length as <paramref name="inputs"/>, in which each element is <c>true</c> if the regular
+                ///     expression finds a match in the string at the same position; otherwise, <c>false</c>.
                 /// </returns>
-                /// <exception cref="System::ArgumentException">
-                ///     A regular expression parsing error occurred.
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="inputs"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="maxDegreeOfParallelism"/> is zero or less than -1.
+                /// </exception>
+                /// <exception cref="System::AggregateException">
+                ///     <para>An element of <paramref name="inputs"/> is <c>null</c>.</para>
+                ///     <para>- or -</para>
+                ///     <para>An element of <paramref name="inputs"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para>An element of <paramref name="inputs"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
+                array<bool>^ IsMatchBatch(IList<String^>^ inputs, int maxDegreeOfParallelism);
+
+
+                /// <summary>
+                ///     Indicates, for each byte array in the specified list, whether the regular expression specified in the <c>Regex</c>
+                ///     constructor finds a match in it, using up to the specified number of threads.
+                /// </summary>
+                /// <param name="inputs">The byte arrays to search for a match.</param>
+                /// <param name="maxDegreeOfParallelism">The maximum number of concurrent threads, or -1 for no limit.</param>
+                /// <returns>
+                ///     An array of the same length as <paramref name="inputs"/>, in which each element is <c>true</c> if the regular
+                ///     expression finds a match in the byte array at the same position; otherwise, <c>false</c>.
+                /// </returns>
                 /// <exception cref="System::ArgumentNullException">
-                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                ///     <paramref name="inputs"/> is <c>null</c>.
                 /// </exception>
                 /// <exception cref="System::ArgumentOutOfRangeException">
-                ///     <para><paramref name="options"/> is not a valid <c>RegexOptions</c> value.</para>
+                ///     <paramref name="maxDegreeOfParallelism"/> is zero or less than -1.
+                /// </exception>
+                /// <exception cref="System::AggregateException">
+                ///     An element of <paramref name="inputs"/> is <c>null</c>.
+                /// </exception>
+                array<bool>^ IsMatchBatch(IList<array<Byte>^>^ inputs, int maxDegreeOfParallelism);
+
+
+                /// <summary>
+                ///     Indicates, for each string in the specified list, whether the regular expression specified in the <c>Regex</c>
+                ///     constructor finds a match in it, using all available processors.
+                /// </summary>
+                /// <param name="inputs">The strings to search for a match.</param>
+                /// <returns>
+                ///     An array of the same length as <paramref name="inputs"/>, in which each element is <c>true</c> if the regular
+                ///     expression finds a match in the string at the same position; otherwise, <c>false</c>.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="inputs"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::AggregateException">
+                ///     <para>An element of <paramref name="inputs"/> is <c>null</c>.</para>
                 ///     <para>- or -</para>
-                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>An element of <paramref name="inputs"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
                 ///     <para>- or -</para>
-                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                ///     <para>An element of <paramref name="inputs"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                static MatchCollection^ Matches(String^ input, String^ pattern, RegexOptions options);
+                array<bool>^ IsMatchBatch(IList<String^>^ inputs);
 
 
                 /// <summary>
-                ///     Searches the specified input byte array for all occurrences of the specified regular expression, using the
-                ///     specified matching options.
+                ///     Indicates, for each byte array in the specified list, whether the regular expression specified in the <c>Regex</c>
+                ///     constructor finds a match in it, using all available processors.
                 /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
-                /// <param name="pattern">
-                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
-                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
-                /// </param>
-                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
+                /// <param name="inputs">The byte arrays to search for a match.</param>
                 /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
+                ///     An array of the same length as <paramref name="inputs"/>, in which each element is <c>true</c> if the regular
+                ///     expression finds a match in the byte array at the same position; otherwise, <c>false</c>.
                 /// </returns>
-                /// <exception cref="System::ArgumentException">
-                ///     A regular expression parsing error occurred.
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="inputs"/> is <c>null</c>.
                 /// </exception>
+                /// <exception cref="System::AggregateException">
+                ///     An element of <paramref name="inputs"/> is <c>null</c>.
+                /// </exception>
+                array<bool>^ IsMatchBatch(IList<array<Byte>^>^ inputs);
+
+
+                /// <summary>
+                ///     Searches each string in the specified list for the first occurrence of the regular expression, using up to the
+                ///     specified number of threads.
+                /// </summary>
+                /// <param name="inputs">The strings to search for a match.</param>
+                /// <param name="maxDegreeOfParallelism">The maximum number of concurrent threads, or -1 for no limit.</param>
+                /// <returns>
+                ///     An array of the same length as <paramref name="inputs"/> holding the first match in each string, or
+                ///     <see cref="Re2::Net::Match::Empty"/> where there is none.
+                /// </returns>
                 /// <exception cref="System::ArgumentNullException">
-                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                ///     <paramref name="inputs"/> is <c>null</c>.
                 /// </exception>
                 /// <exception cref="System::ArgumentOutOfRangeException">
-                ///     <para><paramref name="options"/> is not a valid <c>RegexOptions</c> value.</para>
+                ///     <paramref name="maxDegreeOfParallelism"/> is zero or less than -1.
+                /// </exception>
+                /// <exception cref="System::AggregateException">
+                ///     <para>An element of <paramref name="inputs"/> is <c>null</c>.</para>
                 ///     <para>- or -</para>
-                ///     <para><paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>An element of <paramref name="inputs"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
                 ///     <para>- or -</para>
-                ///     <para><paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                ///     <para>An element of <paramref name="inputs"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                static MatchCollection^ Matches(array<Byte>^ input, String^ pattern, RegexOptions options);
+                array<_Match^>^ MatchBatch(IList<String^>^ inputs, int maxDegreeOfParallelism);
 
 
                 /// <summary>
-                ///     Searches the specified input string for all occurrences of the specified regular expression.
+                ///     Searches each byte array in the specified list for the first occurrence of the regular expression, using up to
+                ///     the specified number of threads.
                 /// </summary>
-                /// <param name="input">The string to search for a match.</param>
-                /// <param name="pattern">
-                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
-                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
-                /// </param>
+                /// <param name="inputs">The byte arrays to search for a match.</param>
+                /// <param name="maxDegreeOfParallelism">The maximum number of concurrent threads, or -1 for no limit.</param>
                 /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
+                ///     An array of the same length as <paramref name="inputs"/> holding the first match in each byte array, or
+                ///     <see cref="Re2::Net::Match::Empty"/> where there is none.
                 /// </returns>
-                /// <exception cref="System::ArgumentException">
-                ///     A regular expression parsing error occurred.
-                /// </exception>
                 /// <exception cref="System::ArgumentNullException">
-                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                ///     <paramref name="inputs"/> is <c>null</c>.
                 /// </exception>
-                static MatchCollection^ Matches(String^ input, String^ pattern);
-                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="maxDegreeOfParallelism"/> is zero or less than -1.
+                /// </exception>
+                /// <exception cref="System::AggregateException">
+                ///     An element of <paramref name="inputs"/> is <c>null</c>.
+                /// </exception>
+                array<_Match^>^ MatchBatch(IList<array<Byte>^>^ inputs, int maxDegreeOfParallelism);
 
 
                 /// <summary>
-                ///     Searches the specified input byte array for all occurrences of the specified regular expression.
+                ///     Searches each string in the specified list for the first occurrence of the regular expression, using all
+                ///     available processors.
                 /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
-                /// <param name="pattern">
-                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
-                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
-                /// </param>
+                /// <param name="inputs">The strings to search for a match.</param>
                 /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
+                ///     An array of the same length as <paramref name="inputs"/> holding the first match in each string, or
+                ///     <see cref="Re2::Net::Match::Empty"/> where there is none.
                 /// </returns>
-                /// <exception cref="System::ArgumentException">
-                ///     A regular expression parsing error occurred.
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="inputs"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::AggregateException">
+                ///     <para>An element of <paramref name="inputs"/> is <c>null</c>.</para>
+                ///     <para>- or -</para>
+                ///     <para>An element of <paramref name="inputs"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para>An element of <paramref name="inputs"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
+                array<_Match^>^ MatchBatch(IList<String^>^ inputs);
+
+
+                /// <summary>
+                ///     Searches each byte array in the specified list for the first occurrence of the regular expression, using all
+                ///     available processors.
+                /// </summary>
+                /// <param name="inputs">The byte arrays to search for a match.</param>
+                /// <returns>
+                ///     An array of the same length as <paramref name="inputs"/> holding the first match in each byte array, or
+                ///     <see cref="Re2::Net::Match::Empty"/> where there is none.
+                /// </returns>
                 /// <exception cref="System::ArgumentNullException">
-                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                ///     <paramref name="inputs"/> is <c>null</c>.
                 /// </exception>
-                static MatchCollection^ Matches(array<Byte>^ input, String^ pattern);
-                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+                /// <exception cref="System::AggregateException">
+                ///     An element of <paramref name="inputs"/> is <c>null</c>.
+                /// </exception>
+                array<_Match^>^ MatchBatch(IList<array<Byte>^>^ inputs);
 
             #pragma endregion
 
         #pragma endregion
 
 
+        #pragma region Background compilation and warm-up
+
+        private:
+
+            /* Constructs, and optionally warms up, a Regex on a thread-pool thread for CompileAsync. */
+            ref class Compilation sealed
+            {
+                private:
+
+                    String^               _pattern;
+                    RegexOptions          _options;
+                    IEnumerable<String^>^ _sampleInputs;
+
+
+                internal:
+
+                    Compilation(String^ pattern, RegexOptions options, IEnumerable<String^>^ sampleInputs);
+
+                    Regex^ Run();
+            };
+
+
+            void _warmUp(const char* data, int size);
+
+
+        public:
+
+            /// <summary>
+            ///     Initializes a new instance of the <c>Regex</c> class for the specified regular expression on a thread-pool thread.
+            /// </summary>
+            /// <param name="pattern">The regular expression pattern to match.</param>
+            /// <returns>
+            ///     A task that completes with the compiled <c>Regex</c>, or faults with the exception the constructor would have
+            ///     thrown.
+            /// </returns>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="pattern"/> is <c>null</c>.
+            /// </exception>
+            static Task<Regex^>^ CompileAsync(String^ pattern);
+
+
+            /// <summary>
+            ///     Initializes a new instance of the <c>Regex</c> class for the specified regular expression, with options that modify
+            ///     the pattern, on a thread-pool thread.
+            /// </summary>
+            /// <param name="pattern">The regular expression pattern to match.</param>
+            /// <param name="options">A bitwise combination of the enumeration values that modify the regular expression.</param>
+            /// <returns>
+            ///     A task that completes with the compiled <c>Regex</c>, or faults with the exception the constructor would have
+            ///     thrown.
+            /// </returns>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="pattern"/> is <c>null</c>.
+            /// </exception>
+            static Task<Regex^>^ CompileAsync(String^ pattern, RegexOptions options);
+
+
+            /// <summary>
+            ///     Initializes a new instance of the <c>Regex</c> class for the specified regular expression, with options that modify
+            ///     the pattern, and warms it up with representative inputs, on a thread-pool thread.
+            /// </summary>
+            /// <param name="pattern">The regular expression pattern to match.</param>
+            /// <param name="options">A bitwise combination of the enumeration values that modify the regular expression.</param>
+            /// <param name="sampleInputs">
+            ///     Inputs like those the <c>Regex</c> will be used on, passed to <see cref="WarmUp(IEnumerable{String})"/>. They are
+            ///     enumerated on the thread-pool thread.
+            /// </param>
+            /// <returns>
+            ///     A task that completes with the compiled <c>Regex</c>, or faults with the exception the constructor or
+            ///     <c>WarmUp</c> would have thrown.
+            /// </returns>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <para><paramref name="pattern"/> is <c>null</c>.</para>
+            ///     <para>- or -</para>
+            ///     <para><paramref name="sampleInputs"/> is <c>null</c>.</para>
+            /// </exception>
+            static Task<Regex^>^ CompileAsync(String^ pattern, RegexOptions options, IEnumerable<String^>^ sampleInputs);
+
+
+            /// <summary>
+            ///     Matches the regular expression against representative inputs, so that the states RE2 builds for them on first
+            ///     use are already cached when real inputs arrive.
+            /// </summary>
+            /// <param name="sampleInputs">Inputs like those the <c>Regex</c> will be used on.</param>
+            /// <remarks>
+            ///     <para>
+            ///         RE2 builds the states of its DFAs lazily, as inputs reach them. Each sample is searched without captures,
+            ///         which fills the forward DFA, and with them, which also fills the reverse DFA used to find where a match
+            ///         starts. The managed matching code is compiled by the JIT along the way.
+            ///     </para>
+            ///     <para>
+            ///         States are only kept up to the memory limit of the <c>Regex</c>; if it is reached, RE2 discards them all.
+            ///         If <see cref="RegexOptions::ThreadReplicas"/> is set, only the copy used by the calling thread is warmed up.
+            ///     </para>
+            /// </remarks>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <para><paramref name="sampleInputs"/> is <c>null</c>.</para>
+            ///     <para>- or -</para>
+            ///     <para>An element of <paramref name="sampleInputs"/> is <c>null</c>.</para>
+            /// </exception>
+            /// <exception cref="System::ArgumentOutOfRangeException">
+            ///     <para>An element of <paramref name="sampleInputs"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+            ///     <para>- or -</para>
+            ///     <para>An element of <paramref name="sampleInputs"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+            /// </exception>
+            void WarmUp(IEnumerable<String^>^ sampleInputs);
+
+
+            /// <summary>
+            ///     Matches the regular expression against representative byte arrays, so that the states RE2 builds for them on
+            ///     first use are already cached when real inputs arrive.
+            /// </summary>
+            /// <param name="sampleInputs">Byte arrays like those the <c>Regex</c> will be used on.</param>
+            /// <remarks>
+            ///     See <see cref="WarmUp(IEnumerable{String})"/>.
+            /// </remarks>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <para><paramref name="sampleInputs"/> is <c>null</c>.</para>
+            ///     <para>- or -</para>
+            ///     <para>An element of <paramref name="sampleInputs"/> is <c>null</c>.</para>
+            /// </exception>
+            void WarmUp(IEnumerable<array<Byte>^>^ sampleInputs);
+
+        #pragma endregion
+
+
+        #pragma region Bulk compilation
+
+        private:
+
+            /* The parallel loop behind CompileAll. Each index is compiled into its own slot of _regexes or _errors. */
+            ref class BulkCompilation sealed
+            {
+                private:
+
+                    IList<Tuple<String^, RegexOptions, int>^>^ _definitions;
+                    array<Regex^>^                             _regexes;
+                    array<String^>^                            _errors;
+
+
+                internal:
+
+                    BulkCompilation(IList<Tuple<String^, RegexOptions, int>^>^ definitions, array<Regex^>^ regexes, array<String^>^ errors);
+
+                    void Run(int maxDegreeOfParallelism);
+                    void Body(Tuple<int, int>^ range);
+            };
+
+
+        public:
+
+            /// <summary>
+            ///     Compiles a list of regular expressions in parallel, without stopping at those that fail to compile.
+            /// </summary>
+            /// <param name="definitions">
+            ///     The pattern, options, and maximum amount of memory, in bytes, of each regular expression, as passed to
+            ///     <see cref="Regex(String, RegexOptions, int)"/>.
+            /// </param>
+            /// <param name="errors">
+            ///     When this method returns, an array of the same length as <paramref name="definitions"/>, containing the error
+            ///     message for each expression that failed to compile, and <c>null</c> for each that compiled.
+            /// </param>
+            /// <param name="addToCache">
+            ///     <c>true</c> to add the compiled expressions to the cache used by the static matching methods; otherwise,
+            ///     <c>false</c>.
+            /// </param>
+            /// <param name="maxDegreeOfParallelism">The maximum number of expressions compiled at once, or -1 for no limit.</param>
+            /// <returns>
+            ///     An array of the same length as <paramref name="definitions"/>, containing each compiled <c>Regex</c>, or
+            ///     <c>null</c> where <paramref name="errors"/> has a message.
+            /// </returns>
+            /// <remarks>
+            ///     <para>
+            ///         The error messages are those of the <c>ArgumentException</c> that the <c>Regex</c> constructor would have
+            ///         thrown, e.g. for a parsing error, an invalid <c>RegexOptions</c> value, or a pattern that isn't valid
+            ///         Latin-1 or ASCII.
+            ///     </para>
+            ///     <para>
+            ///         If <paramref name="addToCache"/> is <c>true</c>, the compiled expressions are added in the order of
+            ///         <paramref name="definitions"/>, replacing cached expressions with the same pattern and options, and
+            ///         evicting the oldest ones once <see cref="CacheSize"/> is reached. The cache doesn't take the memory
+            ///         limit into account, so static methods will use a compiled expression whatever its limit.
+            ///     </para>
+            /// </remarks>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <para><paramref name="definitions"/> is <c>null</c>.</para>
+            ///     <para>- or -</para>
+            ///     <para>An element of <paramref name="definitions"/> is <c>null</c>.</para>
+            /// </exception>
+            /// <exception cref="System::ArgumentOutOfRangeException">
+            ///     <paramref name="maxDegreeOfParallelism"/> is 0 or less than -1.
+            /// </exception>
+            static array<Regex^>^ CompileAll(IEnumerable<Tuple<String^, RegexOptions, int>^>^ definitions, [Out] array<String^>^% errors, bool addToCache, int maxDegreeOfParallelism);
+
+
+            /// <summary>
+            ///     Compiles a list of regular expressions in parallel, without stopping at those that fail to compile.
+            /// </summary>
+            /// <param name="definitions">
+            ///     The pattern, options, and maximum amount of memory, in bytes, of each regular expression, as passed to
+            ///     <see cref="Regex(String, RegexOptions, int)"/>.
+            /// </param>
+            /// <param name="errors">
+            ///     When this method returns, an array of the same length as <paramref name="definitions"/>, containing the error
+            ///     message for each expression that failed to compile, and <c>null</c> for each that compiled.
+            /// </param>
+            /// <param name="addToCache">
+            ///     <c>true</c> to add the compiled expressions to the cache used by the static matching methods; otherwise,
+            ///     <c>false</c>.
+            /// </param>
+            /// <returns>
+            ///     An array of the same length as <paramref name="definitions"/>, containing each compiled <c>Regex</c>, or
+            ///     <c>null</c> where <paramref name="errors"/> has a message.
+            /// </returns>
+            /// <remarks>
+            ///     See <see cref="CompileAll(IEnumerable{Tuple{String, RegexOptions, int}}, array{String}%, bool, int)"/>.
+            /// </remarks>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <para><paramref name="definitions"/> is <c>null</c>.</para>
+            ///     <para>- or -</para>
+            ///     <para>An element of <paramref name="definitions"/> is <c>null</c>.</para>
+            /// </exception>
+            static array<Regex^>^ CompileAll(IEnumerable<Tuple<String^, RegexOptions, int>^>^ definitions, [Out] array<String^>^% errors, bool addToCache);
+
+
+            /// <summary>
+            ///     Compiles a list of regular expressions in parallel, without stopping at those that fail to compile.
+            /// </summary>
+            /// <param name="definitions">
+            ///     The pattern, options, and maximum amount of memory, in bytes, of each regular expression, as passed to
+            ///     <see cref="Regex(String, RegexOptions, int)"/>.
+            /// </param>
+            /// <param name="errors">
+            ///     When this method returns, an array of the same length as <paramref name="definitions"/>, containing the error
+            ///     message for each expression that failed to compile, and <c>null</c> for each that compiled.
+            /// </param>
+            /// <returns>
+            ///     An array of the same length as <paramref name="definitions"/>, containing each compiled <c>Regex</c>, or
+            ///     <c>null</c> where <paramref name="errors"/> has a message.
+            /// </returns>
+            /// <remarks>
+            ///     See <see cref="CompileAll(IEnumerable{Tuple{String, RegexOptions, int}}, array{String}%, bool, int)"/>.
+            /// </remarks>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <para><paramref name="definitions"/> is <c>null</c>.</para>
+            ///     <para>- or -</para>
+            ///     <para>An element of <paramref name="definitions"/> is <c>null</c>.</para>
+            /// </exception>
+            static array<Regex^>^ CompileAll(IEnumerable<Tuple<String^, RegexOptions, int>^>^ definitions, [Out] array<String^>^% errors);
+
+        #pragma endregion
+
+
         #pragma region Constructors and cleanup
 
         public:
@@ -923,11 +2717,6 @@ namespace Net
 
             static Regex();
 
-
-        protected:
-
-            !Regex();
-
         #pragma endregion
 	};
 }
@@ -0,0 +1,126 @@
+/*
+ *  Re2.Net Copyright  2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#include "Regex.h"
+#include "RegexCursor.h"
+#include "RegexInput.h"
+#include "RegexOptions.h"
+#include "Match.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    using re2::RE2;
+    using re2::StringPiece;
+
+    typedef Match _Match;
+
+
+    RegexCursor::RegexCursor(String^ input, RegexOptions options)
+    {
+        if(!input)
+            throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+        _input  = Regex::_convert(input, "input", options);
+        _isUtf8 = _input->IsUTF8;
+    }
+
+
+    RegexCursor::RegexCursor(String^ input)
+    {
+        this->RegexCursor::RegexCursor(input, RegexOptions::None);
+    }
+
+
+    RegexCursor::RegexCursor(array<Byte>^ input, RegexOptions options)
+    {
+        if(!input)
+            throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+        _input  = gcnew RegexInput(input, !RegexOption::HasAnyFlag(options, RegexOptions::Latin1 | RegexOptions::ASCII));
+        _isUtf8 = _input->IsUTF8;
+    }
+
+
+    RegexCursor::RegexCursor(array<Byte>^ input)
+    {
+        this->RegexCursor::RegexCursor(input, RegexOptions::None);
+    }
+
+
+    int RegexCursor::Position::get()
+    {
+        return _stringPosition;
+    }
+
+
+    bool RegexCursor::IsAtEnd::get()
+    {
+        return _position >= _input->Length;
+    }
+
+
+    _Match^ RegexCursor::_consume(Regex^ regex, RE2::Anchor anchor)
+    {
+        if(!regex)
+            throw gcnew ArgumentNullException("regex", "Value cannot be null.");
+        if(_isUtf8 == RegexOption::HasAnyFlag(regex->Options, RegexOptions::Latin1 | RegexOptions::ASCII))
+            throw gcnew ArgumentException("The encoding of the regular expression is not the encoding of the cursor.", "regex");
+
+        int          groupCount = regex->_groupCount();
+        StringPiece* captures   = new StringPiece[groupCount]();
+        _Match^      rv         = _Match::Empty;
+
+        try
+        {
+            /* As in Regex::_match(), byte arrays are only pinned for the search. */
+            pin_ptr<Byte> pinned = nullptr;
+            const char*   data   = _input->Data;
+            if(_input->Bytes)
+            {
+                if(_input->Bytes->Length)
+                    pinned = &_input->Bytes[0];
+                data = (const char*)pinned;
+            }
+
+            if(regex->_search(data, _input->Length, _position, _input->Length, captures, groupCount, anchor))
+            {
+                /*
+                 *  Passing the current position to _create() lets it count String indices from here
+                 *  rather than from the start of the input. The end of the match, in both units, is
+                 *  then the next position.
+                 */
+                rv = regex->_create(_input, data, captures, groupCount, _position, _stringPosition);
+
+                _position       = static_cast<int>(captures[0].data() - data) + captures[0].length();
+                _stringPosition = rv->Index + rv->Length;
+            }
+        }
+        finally
+        {
+            delete[] captures;
+        }
+
+        return rv;
+    }
+
+
+    _Match^ RegexCursor::Consume(Regex^ regex)
+    {
+        return this->_consume(regex, RE2::ANCHOR_START);
+    }
+
+
+    _Match^ RegexCursor::FindAndConsume(Regex^ regex)
+    {
+        return this->_consume(regex, RE2::UNANCHORED);
+    }
+}
+}
\ No newline at end of file
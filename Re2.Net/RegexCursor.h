@@ -0,0 +1,182 @@
+/*
+ *  Re2.Net Copyright  2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#include "Regex.h"
+#include "RegexInput.h"
+#include "RegexOptions.h"
+#include "Match.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    using namespace System;
+
+    ref class Match;
+    ref class Regex;
+
+
+    /// <summary>
+    ///     Scans an input from front to back, matching regular expressions at or after a current position that
+    ///     advances past each match.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///         A string input is converted to the encoding selected by the cursor's options once, in the constructor,
+    ///         and the current position is kept as an offset into the converted data. Consuming a match therefore costs
+    ///         only the search itself, however far into the input the cursor has moved, unlike repeated calls to
+    ///         <c>Regex.Match(input, startIndex)</c>, which convert the whole input each time.
+    ///     </para>
+    ///     <para>
+    ///         Every <c>Regex</c> used with a cursor must have the same encoding as the cursor: Unicode (UTF-8), or one
+    ///         of <c>RegexOptions.Latin1</c> and <c>RegexOptions.ASCII</c>.
+    ///     </para>
+    ///     <para>
+    ///         Like a <c>Match</c>, a <c>RegexCursor</c> over a byte array does not copy it.
+    ///     </para>
+    /// </remarks>
+    public ref class RegexCursor sealed
+    {
+        private:
+
+            /*
+             *  _position       : The current position, as an offset into the converted (or byte) input.
+             *
+             *  _stringPosition : The current position as a String index. Same as _position unless the
+             *                    input is a String converted to UTF-8.
+             */
+            initonly RegexInput^ _input;
+            initonly bool        _isUtf8;
+            int                  _position;
+            int                  _stringPosition;
+
+            _Match^ _consume(Regex^ regex, RE2::Anchor anchor);
+
+
+        public:
+
+            /// <summary>
+            ///     Initializes a new cursor at the start of the specified string, for use with Unicode expressions.
+            /// </summary>
+            /// <param name="input">The string to scan.</param>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="input"/> is <c>null</c>.
+            /// </exception>
+            RegexCursor(String^ input);
+
+
+            /// <summary>
+            ///     Initializes a new cursor at the start of the specified string, for use with expressions that have the
+            ///     encoding selected by the specified options.
+            /// </summary>
+            /// <param name="input">The string to scan.</param>
+            /// <param name="options">
+            ///     A bitwise combination of the enumeration values. Only <c>RegexOptions.Latin1</c> and <c>RegexOptions.ASCII</c>
+            ///     are taken into account.
+            /// </param>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="input"/> is <c>null</c>.
+            /// </exception>
+            /// <exception cref="System::ArgumentOutOfRangeException">
+            ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+            ///     <para>- or -</para>
+            ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+            /// </exception>
+            RegexCursor(String^ input, RegexOptions options);
+
+
+            /// <summary>
+            ///     Initializes a new cursor at the start of the specified byte array, for use with Unicode expressions.
+            /// </summary>
+            /// <param name="input">The byte array to scan.</param>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="input"/> is <c>null</c>.
+            /// </exception>
+            RegexCursor(array<Byte>^ input);
+
+
+            /// <summary>
+            ///     Initializes a new cursor at the start of the specified byte array, for use with expressions that have the
+            ///     encoding selected by the specified options.
+            /// </summary>
+            /// <param name="input">The byte array to scan.</param>
+            /// <param name="options">
+            ///     A bitwise combination of the enumeration values. Only <c>RegexOptions.Latin1</c> and <c>RegexOptions.ASCII</c>
+            ///     are taken into account.
+            /// </param>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="input"/> is <c>null</c>.
+            /// </exception>
+            RegexCursor(array<Byte>^ input, RegexOptions options);
+
+
+            /// <summary>
+            ///     Gets the current position of the cursor.
+            /// </summary>
+            /// <value>
+            ///     The zero-based index in the input at which the next search begins: a character index if the input is a string,
+            ///     or a byte index if the input is a byte array.
+            /// </value>
+            property int Position { int get(); }
+
+
+            /// <summary>
+            ///     Gets a value indicating whether the cursor has reached the end of the input.
+            /// </summary>
+            /// <value>
+            ///     <c>true</c> if no input remains after the current position; otherwise, <c>false</c>.
+            /// </value>
+            property bool IsAtEnd { bool get(); }
+
+
+            /// <summary>
+            ///     Matches the specified regular expression at the current position and, if it succeeds, advances the cursor
+            ///     to the end of the match.
+            /// </summary>
+            /// <param name="regex">The regular expression to match.</param>
+            /// <returns>
+            ///     An object that contains information about the match, with indices relative to the start of the input. If the
+            ///     expression doesn't match at the current position, <see cref="Re2::Net::Match::Empty"/> is returned and the
+            ///     cursor doesn't move.
+            /// </returns>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="regex"/> is <c>null</c>.
+            /// </exception>
+            /// <exception cref="System::ArgumentException">
+            ///     The encoding of <paramref name="regex"/> is not the encoding of the cursor.
+            /// </exception>
+            /// <remarks>
+            ///     This is the equivalent of RE2's <c>Consume</c>. As there, an empty match succeeds without moving the cursor.
+            /// </remarks>
+            _Match^ Consume(Regex^ regex);
+
+
+            /// <summary>
+            ///     Searches for the specified regular expression at or after the current position and, if it is found, advances
+            ///     the cursor to the end of the match.
+            /// </summary>
+            /// <param name="regex">The regular expression to search for.</param>
+            /// <returns>
+            ///     An object that contains information about the match, with indices relative to the start of the input. If the
+            ///     expression isn't found, <see cref="Re2::Net::Match::Empty"/> is returned and the cursor doesn't move.
+            /// </returns>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="regex"/> is <c>null</c>.
+            /// </exception>
+            /// <exception cref="System::ArgumentException">
+            ///     The encoding of <paramref name="regex"/> is not the encoding of the cursor.
+            /// </exception>
+            /// <remarks>
+            ///     This is the equivalent of RE2's <c>FindAndConsume</c>. As there, an empty match succeeds without moving the
+            ///     cursor, other than to its start.
+            /// </remarks>
+            _Match^ FindAndConsume(Regex^ regex);
+    };
+}
+}
\ No newline at end of file
@@ -18,6 +18,36 @@ namespace Net
     using namespace System;
     using namespace System::Runtime::InteropServices;
 
+    using Microsoft::Win32::SafeHandles::SafeHandleZeroOrMinusOneIsInvalid;
+
+
+    /*
+     *  Owns a buffer allocated with malloc(), e.g. a String converted to UTF-8.
+     *
+     *  SafeHandle's finalizer is a critical one, runs after those of ordinary objects,
+     *  and releases nothing while a call holds a reference to the handle, so that the
+     *  objects sharing the buffer don't need finalizers of their own.
+     */
+    private ref class NativeBuffer sealed : SafeHandleZeroOrMinusOneIsInvalid
+    {
+        internal:
+
+            NativeBuffer(const char* data)
+                : SafeHandleZeroOrMinusOneIsInvalid(true)
+            {
+                this->SetHandle(IntPtr(const_cast<char*>(data)));
+            }
+
+
+        protected:
+
+            virtual bool ReleaseHandle() override
+            {
+                free(this->handle.ToPointer());
+                return true;
+            }
+    };
+
 
     /*
      *  Each Match object includes references to the source Regex and the input
@@ -28,34 +58,48 @@ namespace Net
      *  shared_ptr<> would also work for char* input, but not for array<Byte>^
      *  input, which Re2.Net also supports. And the semantics of a managed class
      *  will be more familiar to .NET programmers anyway.
+     *
+     *  RegexInput itself has no finalizer. Whatever needs releasing is held by
+     *  a NativeBuffer (see above), which every Match from the same input shares,
+     *  and which is released once the last of them is collected. Code passing
+     *  Data to native code must keep the RegexInput alive until the call ends.
      */
     private ref class RegexInput
     {
         private:
             
-            initonly String^      _input;
-            initonly array<Byte>^ _bytes;
-            initonly const char*  _data;
-            initonly int          _length;
-            initonly GCHandle^    _handle;
-            initonly bool         _isUtf8;
+            initonly String^       _input;
+            initonly array<Byte>^  _bytes;
+            initonly const char*   _data;
+            initonly int           _offset;
+            initonly int           _length;
+            initonly NativeBuffer^ _storage;
+            initonly bool          _isUtf8;
+            initonly bool          _isBorrowed;
 
 
         internal:
 
             /*
              *  If the RegexInput is created from an unmanaged char array, it assumes
-             *  ownership of the array and deletes it in the dtor.
+             *  ownership of the array, which a NativeBuffer frees.
              *
-             *  If the RegexInput is created from a managed Byte array, the array is
-             *  pinned in memory via GCHandle, which the dtor frees.
+             *  If the RegexInput is created from a managed Byte array, Data is nullptr.
+             *  The array is pinned only for the length of each native call, with
+             *  pin_ptr, so that a long-lived Match doesn't hold a pinned block in the
+             *  heap. A Byte array may be wrapped in part, in which case Offset holds
+             *  the index of the segment in the array.
+             *
+             *  If the RegexInput is created from an IntPtr, the memory is borrowed:
+             *  the caller owns it and must keep it alive and unchanged for as long as
+             *  any Match built on it is in use. Nothing is released.
              *
              *  NB: The point of accepting Byte arrays is that no additional processing
              *      (e.g. UTF-16 -> UTF-8 conversion) or duplication of data is necessary.
              *      It seems natural that Strings, which are immutable by their nature,
              *      are copied, while Byte arrays, which can be edited in-place, are not.
              *      Still I'm open to the idea of modifying the Regex::Match() methods to
-             *      create copies of Byte arrays, which obviates the need for GCHandle.
+             *      create copies of Byte arrays.
              */
 
             static RegexInput^ Empty = gcnew RegexInput(String::Empty, nullptr, 0, false);
@@ -63,21 +107,49 @@ namespace Net
             RegexInput(String^ input, const char* data, int length, bool isUtf8)
                 : _input(input),
                   _data(data),
+                  _offset(0),
                   _length(length),
                   _isUtf8(isUtf8),
+                  _isBorrowed(false),
                   _bytes(nullptr),
-                  _handle(nullptr)
+                  _storage(data ? gcnew NativeBuffer(data) : nullptr)
             {
             }
                     
             RegexInput(array<Byte>^ bytes, bool isUtf8)
+                : _input(String::Empty),
+                  _data(nullptr),
+                  _offset(0),
+                  _length(bytes->Length),
+                  _isUtf8(isUtf8),
+                  _isBorrowed(false),
+                  _bytes(bytes),
+                  _storage(nullptr)
+            {
+            }
+
+            RegexInput(array<Byte>^ bytes, int offset, int count, bool isUtf8)
+                : _input(String::Empty),
+                  _data(nullptr),
+                  _offset(offset),
+                  _length(count),
+                  _isUtf8(isUtf8),
+                  _isBorrowed(false),
+                  _bytes(bytes),
+                  _storage(nullptr)
+            {
+            }
+
+            RegexInput(IntPtr data, int length, bool isUtf8)
+                : _input(String::Empty),
+                  _data((const char*)data.ToPointer()),
+                  _offset(0),
+                  _length(length),
+                  _isUtf8(isUtf8),
+                  _isBorrowed(true),
+                  _bytes(nullptr),
+                  _storage(nullptr)
             {
-                _bytes  = bytes;
-                _handle = GCHandle::Alloc(bytes, GCHandleType::Pinned);
-                _length = bytes->Length;
-                _data   = (const char*)_handle->AddrOfPinnedObject().ToPointer();
-                _isUtf8 = isUtf8;
-                _input  = String::Empty;
             }
             
             property String^ Input
@@ -95,6 +167,11 @@ namespace Net
                 const char* get() { return _data; }
             }
 
+            property int Offset
+            {
+                int get() { return _offset; }
+            }
+
             property int Length
             {
                 int get() { return _length; }
@@ -105,20 +182,18 @@ namespace Net
                 bool get() { return _isUtf8; }
             }
 
-            ~RegexInput()
+            property bool IsBorrowed
             {
-                this->!RegexInput();
+                bool get() { return _isBorrowed; }
             }
-        
-    
-        protected:
-            
-            !RegexInput()
+
+            /*
+             *  True if Data is a conversion of Input, in which case Match indices have
+             *  to be translated back into String indices. Otherwise they are byte offsets.
+             */
+            property bool IsString
             {
-                if(_handle)
-                    _handle->Free();
-                else
-                    free(const_cast<char*>(_data));
+                bool get() { return !_bytes && !_isBorrowed; }
             }
     };
 }
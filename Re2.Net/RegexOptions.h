@@ -63,16 +63,23 @@ namespace Net
         
         /// <summary>
         ///     Specifies that the pattern is treated as a string literal rather than a regular
-        ///     expression.
+        ///     expression. Unless <c>IgnoreNewline</c> is set, or <c>IgnoreCase</c> is set and the
+        ///     literal isn't plain ASCII (or, in UTF-8 mode, contains a 'k' or an 's', which also fold
+        ///     to non-ASCII characters), the literal is searched for directly rather than with RE2,
+        ///     and in UTF-8 mode a string input is searched without being converted.
         /// </summary>
         Literal = 1 << 6,
 
-        ///// <summary>
-        /////     Specifies that the only valid captures are explicitly named or numbered groups of
-        /////     the form (?&lt;name&gt;...). This allows unnamed parentheses to act as noncapturing
-        /////     groups without the syntactic clumsiness of the expression (?:...).
-        ///// </summary>
-        //ExplicitCapture = 1 << 7,
+        /// <summary>
+        ///     Specifies that the only valid captures are explicitly named groups of the form
+        ///     (?P&lt;name&gt;...). This allows unnamed parentheses to act as noncapturing groups
+        ///     without the syntactic clumsiness of the expression (?:...).
+        /// </summary>
+        /// <remarks>
+        ///     Named groups are numbered from 1, in order. This option has no effect with <c>Literal</c>,
+        ///     or with <c>POSIX</c>, whose syntax has no noncapturing groups.
+        /// </remarks>
+        ExplicitCapture = 1 << 7,
 
         /// <summary>
         ///     Specifies that only the regular expression as a whole is captured. This significantly
@@ -124,7 +131,27 @@ namespace Net
         ///     Specifies one-line mode: '^' and '$' only match the start and end of the input.
         ///     This option is always enabled and can only be turned off in POSIX mode.
         /// </summary>
-        OneLine = 1 << 14
+        OneLine = 1 << 14,
+
+        /// <summary>
+        ///     Specifies that matching threads use private copies of the compiled expression,
+        ///     created on first use and bounded by the number of processors. Without this option,
+        ///     threads sharing a <c>Regex</c> instance contend for the lock guarding its automata.
+        /// </summary>
+        /// <remarks>
+        ///     Each copy has its own memory budget of <c>Regex.MaxMemory</c> bytes. See
+        ///     <c>Regex.ReplicaCount</c> and <c>Regex.MemoryBudget</c>.
+        /// </remarks>
+        ThreadReplicas = 1 << 15,
+
+        /// <summary>
+        ///     Specifies that the <c>Regex</c> counts its calls, and the time they spend converting input, searching,
+        ///     translating positions, and creating <c>Match</c> objects, in <c>Regex.Telemetry</c>.
+        /// </summary>
+        /// <remarks>
+        ///     Without this option, the only cost of telemetry is a null check per search.
+        /// </remarks>
+        Telemetry = 1 << 16
     };
 
     [ExtensionAttribute]
@@ -0,0 +1,1041 @@
+/*
+ *  Re2.Net Copyright  2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#pragma managed(push, off)
+    #include <string.h>
+    #include <algorithm>
+    #include <map>
+    #include <string>
+    #include <utility>
+    #include <vector>
+#pragma managed(pop)
+
+#include <vcclr.h>
+#include "Regex.h"
+#include "RegexSet.h"
+#include "RegexInput.h"
+#include "RegexOptions.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    using namespace System;
+
+    using System::Collections::Generic::List;
+    using System::Threading::Interlocked;
+
+    using std::string;
+    using std::vector;
+
+
+    #pragma region Prefilter
+
+    #pragma managed(push, off)
+
+        /*
+         *  MIN_ATOM_LENGTH : Atoms shorter than this are too common to be worth requiring. An exact
+         *                    set with a shorter string is treated as matching anything.
+         *
+         *  MAX_EXACT       : The largest exact set kept before it is turned into an OR of atoms.
+         */
+        static const size_t MIN_ATOM_LENGTH = 3;
+        static const size_t MAX_EXACT       = 16;
+
+
+        /* Atoms and input are compared with ASCII letters folded to lower case. */
+        static inline unsigned char FoldByte(unsigned char c)
+        {
+            return c >= 'A' && c <= 'Z' ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+        }
+
+
+        /*
+         *  Scans input for any number of atoms at once. The trie's root has a full transition
+         *  table, which the scan spends most of its time in; other states keep a short list.
+         */
+        class AtomScanner
+        {
+            private:
+
+                /*
+                 *  fail   : The state for the longest proper suffix of this state's string that is in the trie.
+                 *
+                 *  atom   : The atom ending at this state, or -1.
+                 *
+                 *  output : The nearest state along the fail links that ends an atom, or 0.
+                 */
+                struct State
+                {
+                    int                                      fail;
+                    int                                      atom;
+                    int                                      output;
+                    vector<std::pair<unsigned char, int> >   next;
+
+                    State() : fail(0), atom(-1), output(0) { }
+                };
+
+                vector<State> _states;
+                int           _root[256];
+
+                int Child(int state, unsigned char c) const
+                {
+                    const vector<std::pair<unsigned char, int> >& next = _states[state].next;
+                    for(size_t i = 0; i < next.size(); ++i)
+                        if(next[i].first == c)
+                            return next[i].second;
+                    return -1;
+                }
+
+
+            public:
+
+                AtomScanner() : _states(1)
+                {
+                    memset(_root, 0, sizeof(_root));
+                }
+
+
+                void Build(const vector<string>& atoms)
+                {
+                    for(size_t a = 0; a < atoms.size(); ++a)
+                    {
+                        int state = 0;
+                        for(size_t i = 0; i < atoms[a].size(); ++i)
+                        {
+                            unsigned char c    = static_cast<unsigned char>(atoms[a][i]);
+                            int           next = Child(state, c);
+                            if(next < 0)
+                            {
+                                next = static_cast<int>(_states.size());
+                                _states.push_back(State());
+                                _states[state].next.push_back(std::make_pair(c, next));
+                            }
+                            state = next;
+                        }
+                        _states[state].atom = static_cast<int>(a);
+                    }
+
+                    /* Fail links, breadth first, so that a state's fail link is done before its children's. */
+                    vector<int> queue;
+                    for(size_t i = 0; i < _states[0].next.size(); ++i)
+                    {
+                        _root[_states[0].next[i].first] = _states[0].next[i].second;
+                        queue.push_back(_states[0].next[i].second);
+                    }
+
+                    for(size_t q = 0; q < queue.size(); ++q)
+                    {
+                        int parent = queue[q];
+                        for(size_t i = 0; i < _states[parent].next.size(); ++i)
+                        {
+                            unsigned char c     = _states[parent].next[i].first;
+                            int           child = _states[parent].next[i].second;
+                            int           fail  = _states[parent].fail;
+
+                            while(fail && Child(fail, c) < 0)
+                                fail = _states[fail].fail;
+
+                            fail = fail ? Child(fail, c) : _root[c];
+
+                            _states[child].fail   = fail;
+                            _states[child].output = _states[fail].atom >= 0 ? fail : _states[fail].output;
+                            queue.push_back(child);
+                        }
+                    }
+                }
+
+
+                /* Sets hits[i] for every atom i found in data. */
+                void Scan(const unsigned char* data, int size, unsigned char* hits) const
+                {
+                    int state = 0;
+                    for(int i = 0; i < size; ++i)
+                    {
+                        unsigned char c = FoldByte(data[i]);
+                        for(;;)
+                        {
+                            if(!state)
+                            {
+                                state = _root[c];
+                                break;
+                            }
+
+                            int next = Child(state, c);
+                            if(next >= 0)
+                            {
+                                state = next;
+                                break;
+                            }
+                            state = _states[state].fail;
+                        }
+
+                        for(int out = _states[state].atom >= 0 ? state : _states[state].output; out; out = _states[out].output)
+                            hits[_states[out].atom] = 1;
+                    }
+                }
+        };
+
+
+        /*
+         *  The requirements of a set of patterns, after RE2's prefilter. A requirement is an
+         *  AND/OR tree of atoms; node 0 is ALL, the requirement that every string meets.
+         */
+        class Prefilter
+        {
+            private:
+
+                enum Op { ALL, ATOM, AND, OR };
+
+                struct Node
+                {
+                    Op          op;
+                    int         atom;
+                    vector<int> subs;
+                };
+
+                /*
+                 *  What is known about the strings a (sub)pattern matches: either the exact set of them,
+                 *  if that set is small, or a requirement that each of them meets. An exact set can be
+                 *  turned into a requirement, the OR of its strings, but not back.
+                 */
+                struct Info
+                {
+                    bool           isExact;
+                    vector<string> exact;
+                    int            match;
+
+                    static Info Exact(const string& s)
+                    {
+                        Info rv;
+                        rv.isExact = true;
+                        rv.exact.push_back(s);
+                        rv.match   = 0;
+                        return rv;
+                    }
+
+                    static Info Match(int node)
+                    {
+                        Info rv;
+                        rv.isExact = false;
+                        rv.match   = node;
+                        return rv;
+                    }
+
+                    static Info Any()
+                    {
+                        return Match(0);
+                    }
+                };
+
+                vector<Node>          _nodes;
+                vector<string>        _atoms;
+                std::map<string, int> _atomIds;
+                vector<int>           _roots;
+                AtomScanner           _scanner;
+
+                /* Parser state for the pattern being added. */
+                const wchar_t* _p;
+                const wchar_t* _end;
+                bool           _isUtf8;
+                bool           _failed;
+
+
+                #pragma region Requirement trees
+
+                int NewNode(Op op, int atom)
+                {
+                    Node node;
+                    node.op   = op;
+                    node.atom = atom;
+                    _nodes.push_back(node);
+                    return static_cast<int>(_nodes.size()) - 1;
+                }
+
+
+                int Atom(const string& atom)
+                {
+                    std::map<string, int>::const_iterator it = _atomIds.find(atom);
+                    int id;
+                    if(it != _atomIds.end())
+                        id = it->second;
+                    else
+                    {
+                        id = static_cast<int>(_atoms.size());
+                        _atoms.push_back(atom);
+                        _atomIds[atom] = id;
+                    }
+                    return NewNode(ATOM, id);
+                }
+
+
+                /* ALL is the identity of AND and absorbs OR. Nested nodes of the same op are flattened. */
+                int Combine(Op op, int a, int b)
+                {
+                    if(!a || !b)
+                        return op == AND ? (a ? a : b) : 0;
+
+                    int node = NewNode(op, -1);
+                    for(int side = 0; side < 2; ++side)
+                    {
+                        int sub = side ? b : a;
+                        if(_nodes[sub].op == op)
+                            _nodes[node].subs.insert(_nodes[node].subs.end(), _nodes[sub].subs.begin(), _nodes[sub].subs.end());
+                        else
+                            _nodes[node].subs.push_back(sub);
+                    }
+                    return node;
+                }
+
+
+                /*
+                 *  Turns an exact set into the OR of its strings as atoms. A string that contains a shorter
+                 *  one adds nothing to the OR and is dropped. A string too short to be an atom makes the
+                 *  OR match anything.
+                 */
+                int ToMatch(const Info& info)
+                {
+                    if(!info.isExact)
+                        return info.match;
+
+                    vector<string> strings;
+                    for(size_t i = 0; i < info.exact.size(); ++i)
+                    {
+                        string s = info.exact[i];
+                        if(s.size() < MIN_ATOM_LENGTH)
+                            return 0;
+                        for(size_t k = 0; k < s.size(); ++k)
+                            s[k] = static_cast<char>(FoldByte(static_cast<unsigned char>(s[k])));
+                        strings.push_back(s);
+                    }
+
+                    std::sort(strings.begin(), strings.end(), [](const string& x, const string& y) {
+                        return x.size() != y.size() ? x.size() < y.size() : x < y;
+                    });
+
+                    int rv = -1;
+                    vector<string> kept;
+                    for(size_t i = 0; i < strings.size(); ++i)
+                    {
+                        bool redundant = false;
+                        for(size_t k = 0; k < kept.size() && !redundant; ++k)
+                            redundant = strings[i].find(kept[k]) != string::npos;
+                        if(redundant)
+                            continue;
+
+                        kept.push_back(strings[i]);
+                        int atom = Atom(strings[i]);
+                        rv = rv < 0 ? atom : Combine(OR, rv, atom);
+                    }
+                    return rv;
+                }
+
+
+                Info Concat(const Info& a, const Info& b)
+                {
+                    if(a.isExact && b.isExact && a.exact.size() * b.exact.size() <= MAX_EXACT)
+                    {
+                        Info rv;
+                        rv.isExact = true;
+                        rv.match   = 0;
+                        for(size_t i = 0; i < a.exact.size(); ++i)
+                            for(size_t k = 0; k < b.exact.size(); ++k)
+                                rv.exact.push_back(a.exact[i] + b.exact[k]);
+                        std::sort(rv.exact.begin(), rv.exact.end());
+                        rv.exact.erase(std::unique(rv.exact.begin(), rv.exact.end()), rv.exact.end());
+                        return rv;
+                    }
+                    return Info::Match(Combine(AND, ToMatch(a), ToMatch(b)));
+                }
+
+
+                Info Alternate(const Info& a, const Info& b)
+                {
+                    if(a.isExact && b.isExact && a.exact.size() + b.exact.size() <= MAX_EXACT)
+                    {
+                        Info rv = a;
+                        rv.exact.insert(rv.exact.end(), b.exact.begin(), b.exact.end());
+                        std::sort(rv.exact.begin(), rv.exact.end());
+                        rv.exact.erase(std::unique(rv.exact.begin(), rv.exact.end()), rv.exact.end());
+                        return rv;
+                    }
+                    return Info::Match(Combine(OR, ToMatch(a), ToMatch(b)));
+                }
+
+                #pragma endregion
+
+
+                #pragma region Pattern analysis
+
+                /*
+                 *  A literal code point. Under case folding, only ASCII letters are kept, as the scanner
+                 *  folds them anyway; 'k' and 's' are not, as RE2 also folds them to U+212A (KELVIN SIGN)
+                 *  and U+017F (LATIN SMALL LETTER LONG S).
+                 */
+                Info Literal(int c, bool foldCase)
+                {
+                    if(foldCase && (c >= 0x80 || c == 'k' || c == 'K' || c == 's' || c == 'S'))
+                        return Info::Any();
+
+                    string s;
+                    if(!_isUtf8 || c < 0x80)
+                    {
+                        if(c > 0xff)
+                            return Info::Any();
+                        s += static_cast<char>(c);
+                    }
+                    else if(c < 0x800)
+                    {
+                        s += static_cast<char>(0xc0 | (c >> 6));
+                        s += static_cast<char>(0x80 | (c & 0x3f));
+                    }
+                    else if(c < 0x10000)
+                    {
+                        s += static_cast<char>(0xe0 | (c >> 12));
+                        s += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+                        s += static_cast<char>(0x80 | (c & 0x3f));
+                    }
+                    else
+                    {
+                        s += static_cast<char>(0xf0 | (c >> 18));
+                        s += static_cast<char>(0x80 | ((c >> 12) & 0x3f));
+                        s += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+                        s += static_cast<char>(0x80 | (c & 0x3f));
+                    }
+                    return Info::Exact(s);
+                }
+
+
+                /* Reads one code point, joining a surrogate pair. */
+                int Next()
+                {
+                    int c = *_p++;
+                    if(c >= 0xd800 && c <= 0xdbff && _p < _end && *_p >= 0xdc00 && *_p <= 0xdfff)
+                        c = (c - 0xd800) * 0x400 + (*_p++ - 0xdc00) + 0x10000;
+                    return c;
+                }
+
+
+                static int HexValue(wchar_t c)
+                {
+                    return c >= '0' && c <= '9' ? c - '0' :
+                           c >= 'a' && c <= 'f' ? c - 'a' + 10 :
+                           c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+                }
+
+
+                Info Escape(bool foldCase)
+                {
+                    if(_p == _end)
+                    {
+                        _failed = true;
+                        return Info::Any();
+                    }
+
+                    wchar_t c = *_p++;
+                    switch(c)
+                    {
+                        /* Empty-width assertions. */
+                        case 'b': case 'B': case 'A': case 'z':
+                            return Info::Exact("");
+
+                        case 'p': case 'P':
+                            if(_p < _end && *_p == '{')
+                                while(_p < _end && *_p++ != '}') { }
+                            else if(_p < _end)
+                                ++_p;
+                            return Info::Any();
+
+                        case 'Q':
+                        {
+                            Info rv = Info::Exact("");
+                            while(_p < _end && !(*_p == '\\' && _p + 1 < _end && _p[1] == 'E'))
+                                rv = Concat(rv, Literal(Next(), foldCase));
+                            if(_p < _end)
+                                _p += 2;
+                            return rv;
+                        }
+
+                        case 'x':
+                        {
+                            int value = 0;
+                            if(_p < _end && *_p == '{')
+                            {
+                                for(++_p; _p < _end && *_p != '}'; ++_p)
+                                {
+                                    if(HexValue(*_p) < 0 || value > 0x10ffff)
+                                    {
+                                        _failed = true;
+                                        return Info::Any();
+                                    }
+                                    value = value * 16 + HexValue(*_p);
+                                }
+                                if(_p < _end)
+                                    ++_p;
+                            }
+                            else
+                            {
+                                for(int i = 0; i < 2; ++i, ++_p)
+                                {
+                                    if(_p == _end || HexValue(*_p) < 0)
+                                    {
+                                        _failed = true;
+                                        return Info::Any();
+                                    }
+                                    value = value * 16 + HexValue(*_p);
+                                }
+                            }
+                            return Literal(value, foldCase);
+                        }
+
+                        case 'n': return Literal('\n', foldCase);
+                        case 't': return Literal('\t', foldCase);
+                        case 'r': return Literal('\r', foldCase);
+                        case 'f': return Literal('\f', foldCase);
+                        case 'v': return Literal('\v', foldCase);
+                        case 'a': return Literal('\a', foldCase);
+
+                        default:
+                            /* Octal escapes are consumed whole; they rarely appear in atoms. */
+                            if(c >= '0' && c <= '7')
+                            {
+                                for(int i = 0; i < 2 && _p < _end && *_p >= '0' && *_p <= '7'; ++i)
+                                    ++_p;
+                                return Info::Any();
+                            }
+
+                            /* An escaped punctuation character is itself. Any other escape is a class (\d, \C, ...). */
+                            if(c < 0x80 && !((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')))
+                                return Literal(c, foldCase);
+                            return Info::Any();
+                    }
+                }
+
+
+                void SkipClass()
+                {
+                    /* A ']' directly after '[' or '[^' is a member, not the end of the class. */
+                    if(_p < _end && *_p == '^')
+                        ++_p;
+                    if(_p < _end && *_p == ']')
+                        ++_p;
+
+                    while(_p < _end && *_p != ']')
+                    {
+                        if(*_p == '\\')
+                            _p += _p + 1 < _end ? 2 : 1;
+                        else if(*_p == '[' && _p + 1 < _end && _p[1] == ':')
+                        {
+                            const wchar_t* close = _p + 2;
+                            while(close + 1 < _end && !(close[0] == ':' && close[1] == ']'))
+                                ++close;
+                            _p = close + 1 < _end ? close + 2 : _end;
+                        }
+                        else
+                            ++_p;
+                    }
+
+                    if(_p == _end)
+                        _failed = true;
+                    else
+                        ++_p;
+                }
+
+
+                /* Applies any repetition operators that follow an item. */
+                Info Repetition(Info item)
+                {
+                    while(!_failed && _p < _end)
+                    {
+                        if(*_p == '*' || *_p == '?')
+                        {
+                            ++_p;
+                            item = Info::Any();
+                        }
+                        else if(*_p == '+')
+                        {
+                            ++_p;
+                            item = Info::Match(ToMatch(item));
+                        }
+                        else if(*_p == '{')
+                        {
+                            /* A '{' that doesn't start a valid {n}, {n,}, or {n,m} is a literal. */
+                            const wchar_t* q   = _p + 1;
+                            int            min = 0;
+                            bool           any = false;
+                            for(; q < _end && *q >= '0' && *q <= '9'; ++q, any = true)
+                                min = min < 100000 ? min * 10 + (*q - '0') : min;
+                            if(!any)
+                                break;
+                            if(q < _end && *q == ',')
+                                for(++q; q < _end && *q >= '0' && *q <= '9'; ++q) { }
+                            if(q == _end || *q != '}')
+                                break;
+
+                            _p   = q + 1;
+                            item = min ? Info::Match(ToMatch(item)) : Info::Any();
+                        }
+                        else
+                            break;
+
+                        /* Non-greedy. */
+                        if(_p < _end && *_p == '?')
+                            ++_p;
+                    }
+                    return item;
+                }
+
+
+                /* Parses one item into info. Returns false if it was a flag group, such as (?i), instead. */
+                bool Item(bool& foldCase, Info& info)
+                {
+                    int c = Next();
+                    switch(c)
+                    {
+                        case '(':
+                        {
+                            bool groupFoldCase = foldCase;
+                            if(_p < _end && *_p == '?')
+                            {
+                                ++_p;
+                                if(_p < _end && *_p == 'P')
+                                {
+                                    while(_p < _end && *_p != '>')
+                                        ++_p;
+                                    if(_p < _end)
+                                        ++_p;
+                                }
+                                else
+                                {
+                                    bool negated = false;
+                                    while(_p < _end && *_p != ')' && *_p != ':')
+                                    {
+                                        wchar_t flag = *_p++;
+                                        if(flag == '-')
+                                            negated = true;
+                                        else if(flag == 'i')
+                                            groupFoldCase = !negated;
+                                        else if(flag != 'm' && flag != 's' && flag != 'U')
+                                            _failed = true;
+                                    }
+                                    if(_p == _end)
+                                        _failed = true;
+                                    else if(*_p++ == ')')
+                                    {
+                                        /* (?flags) applies to the rest of the enclosing group. */
+                                        foldCase = groupFoldCase;
+                                        return false;
+                                    }
+                                }
+                            }
+
+                            info = Alternation(groupFoldCase);
+                            if(_p < _end && *_p == ')')
+                                ++_p;
+                            else
+                                _failed = true;
+                            return true;
+                        }
+
+                        case '[':
+                            SkipClass();
+                            info = Info::Any();
+                            return true;
+
+                        case '.':
+                            info = Info::Any();
+                            return true;
+
+                        case '^':
+                        case '$':
+                            info = Info::Exact("");
+                            return true;
+
+                        case '\\':
+                            info = Escape(foldCase);
+                            return true;
+
+                        case '*':
+                        case '+':
+                        case '?':
+                            _failed = true;
+                            info = Info::Any();
+                            return true;
+
+                        default:
+                            info = Literal(c, foldCase);
+                            return true;
+                    }
+                }
+
+
+                /*
+                 *  Consecutive exact items are joined into a run before the run is turned into atoms, so
+                 *  that "abc.*def" requires "def", not "d", "e", and "f" (each too short to be an atom).
+                 */
+                Info Concatenation(bool& foldCase)
+                {
+                    Info run     = Info::Exact("");
+                    int  match   = 0;
+                    bool isExact = true;
+
+                    while(!_failed && _p < _end && *_p != '|' && *_p != ')')
+                    {
+                        Info item;
+                        if(!Item(foldCase, item))
+                            continue;
+
+                        item = Repetition(item);
+                        if(item.isExact && run.exact.size() * item.exact.size() <= MAX_EXACT)
+                        {
+                            run = Concat(run, item);
+                            continue;
+                        }
+
+                        isExact = false;
+                        match   = Combine(AND, match, ToMatch(run));
+                        if(item.isExact)
+                            run = item;
+                        else
+                        {
+                            match = Combine(AND, match, item.match);
+                            run   = Info::Exact("");
+                        }
+                    }
+
+                    return isExact ? run : Info::Match(Combine(AND, match, ToMatch(run)));
+                }
+
+
+                /* Flags set by (?i) persist across '|' until the end of the group. */
+                Info Alternation(bool foldCase)
+                {
+                    Info rv = Concatenation(foldCase);
+                    while(!_failed && _p < _end && *_p == '|')
+                    {
+                        ++_p;
+                        rv = Alternate(rv, Concatenation(foldCase));
+                    }
+                    return rv;
+                }
+
+                #pragma endregion
+
+
+                bool Passes(int node, const unsigned char* hits) const
+                {
+                    const Node& n = _nodes[node];
+                    switch(n.op)
+                    {
+                        case ATOM:
+                            return hits[n.atom] != 0;
+
+                        case AND:
+                            for(size_t i = 0; i < n.subs.size(); ++i)
+                                if(!Passes(n.subs[i], hits))
+                                    return false;
+                            return true;
+
+                        case OR:
+                            for(size_t i = 0; i < n.subs.size(); ++i)
+                                if(Passes(n.subs[i], hits))
+                                    return true;
+                            return false;
+
+                        default:
+                            return true;
+                    }
+                }
+
+
+            public:
+
+                Prefilter() : _p(nullptr), _end(nullptr), _isUtf8(true), _failed(false)
+                {
+                    NewNode(ALL, -1);
+                }
+
+
+                /*
+                 *  Extracts the requirement of a pattern that RE2 has already compiled. Anything the
+                 *  analysis doesn't understand makes the pattern unfiltered, which is always safe.
+                 */
+                void Add(const wchar_t* pattern, int length, bool isUtf8, bool foldCase, bool isLiteral)
+                {
+                    _p      = pattern;
+                    _end    = pattern + length;
+                    _isUtf8 = isUtf8;
+                    _failed = false;
+
+                    Info info = Info::Exact("");
+                    if(isLiteral)
+                        while(_p < _end)
+                            info = Concat(info, Literal(Next(), foldCase));
+                    else
+                    {
+                        info = Alternation(foldCase);
+                        if(_p != _end)
+                            _failed = true;
+                    }
+
+                    _roots.push_back(_failed ? 0 : ToMatch(info));
+                }
+
+
+                /* Builds the scanner once every pattern has been added. */
+                void Compile()
+                {
+                    _scanner.Build(_atoms);
+                }
+
+
+                int AtomCount() const
+                {
+                    return static_cast<int>(_atoms.size());
+                }
+
+
+                bool IsUnfiltered(int index) const
+                {
+                    return !_roots[index];
+                }
+
+
+                void Scan(const char* data, int size, unsigned char* hits) const
+                {
+                    _scanner.Scan(reinterpret_cast<const unsigned char*>(data), size, hits);
+                }
+
+
+                /* Whether the pattern at index is a candidate, given the atoms found by Scan(). */
+                bool IsCandidate(int index, const unsigned char* hits) const
+                {
+                    return Passes(_roots[index], hits);
+                }
+        };
+
+    #pragma managed(pop)
+
+    #pragma endregion
+
+
+    #pragma region RegexSet
+
+        RegexSet::PrefilterHandle::PrefilterHandle(const Prefilter* prefilter)
+            : SafeHandleZeroOrMinusOneIsInvalid(true)
+        {
+            this->SetHandle(IntPtr(const_cast<Prefilter*>(prefilter)));
+        }
+
+
+        bool RegexSet::PrefilterHandle::ReleaseHandle()
+        {
+            delete static_cast<Prefilter*>(this->handle.ToPointer());
+            return true;
+        }
+
+
+        RegexSet::RegexSet(IEnumerable<String^>^ patterns, RegexOptions options)
+        {
+            if(!patterns)
+                throw gcnew ArgumentNullException("patterns", "Value cannot be null.");
+
+            List<Regex^>^ regexes = gcnew List<Regex^>();
+            for each(String^ pattern in patterns)
+            {
+                if(!pattern)
+                    throw gcnew ArgumentNullException("patterns", "The collection contains a null element.");
+                regexes->Add(gcnew Regex(pattern, options));
+            }
+
+            _regexes = regexes->ToArray();
+            _options = options;
+
+            Prefilter* prefilter = new Prefilter();
+            _handle    = gcnew PrefilterHandle(prefilter);
+            _prefilter = prefilter;
+
+            bool isUtf8    = !RegexOption::HasAnyFlag(options, RegexOptions::Latin1 | RegexOptions::ASCII);
+            bool foldCase  = RegexOption::HasAnyFlag(options, RegexOptions::IgnoreCase);
+            bool isLiteral = RegexOption::HasAnyFlag(options, RegexOptions::Literal);
+            int  unfiltered = 0;
+
+            for(int i = 0; i < _regexes->Length; i++)
+            {
+                String^                pattern = _regexes[i]->Pattern;
+                pin_ptr<const wchar_t> chars   = PtrToStringChars(pattern);
+
+                prefilter->Add(chars, pattern->Length, isUtf8, foldCase, isLiteral);
+                if(prefilter->IsUnfiltered(i))
+                    unfiltered++;
+            }
+
+            prefilter->Compile();
+            _unfiltered = unfiltered;
+        }
+
+
+        RegexSet::RegexSet(IEnumerable<String^>^ patterns)
+        {
+            this->RegexSet::RegexSet(patterns, RegexOptions::None);
+        }
+
+
+        RegexSet::~RegexSet()
+        {
+            if(_handle)
+                delete _handle;
+        }
+
+
+        int RegexSet::Count::get()
+        {
+            return _regexes->Length;
+        }
+
+
+        Regex^ RegexSet::default::get(int index)
+        {
+            return _regexes[index];
+        }
+
+
+        RegexOptions RegexSet::Options::get()
+        {
+            return _options;
+        }
+
+
+        int RegexSet::UnfilteredCount::get()
+        {
+            return _unfiltered;
+        }
+
+
+        Int64 RegexSet::InputCount::get()
+        {
+            return Interlocked::Read(_inputs);
+        }
+
+
+        Int64 RegexSet::CandidateCount::get()
+        {
+            return Interlocked::Read(_candidates);
+        }
+
+
+        Int64 RegexSet::MatchCount::get()
+        {
+            return Interlocked::Read(_matches);
+        }
+
+
+        double RegexSet::CandidateRate::get()
+        {
+            Int64 possible = Interlocked::Read(_inputs) * _regexes->Length;
+            return possible ? static_cast<double>(Interlocked::Read(_candidates)) / possible : 0;
+        }
+
+
+        void RegexSet::ResetCounters()
+        {
+            Interlocked::Exchange(_inputs, 0);
+            Interlocked::Exchange(_candidates, 0);
+            Interlocked::Exchange(_matches, 0);
+        }
+
+
+        array<int>^ RegexSet::_match(const char* data, int size, bool first)
+        {
+            vector<unsigned char> hits(_prefilter->AtomCount() + 1);
+            _prefilter->Scan(data, size, hits.data());
+
+            List<int>^ rv         = gcnew List<int>();
+            int        candidates = 0;
+
+            for(int i = 0; i < _regexes->Length; i++)
+            {
+                if(!_prefilter->IsCandidate(i, hits.data()))
+                    continue;
+
+                candidates++;
+                if(_regexes[i]->_search(data, size, 0, size, NULL, 0))
+                {
+                    rv->Add(i);
+                    if(first)
+                        break;
+                }
+            }
+
+            /* See Regex::_search(). */
+            GC::KeepAlive(this);
+
+            Interlocked::Increment(_inputs);
+            Interlocked::Add(_candidates, candidates);
+            Interlocked::Add(_matches, rv->Count);
+
+            return rv->ToArray();
+        }
+
+
+        /* The prefilter scans the bytes before any Regex does, so this pins them as Regex::_search(array<Byte>^) does. */
+        array<int>^ RegexSet::_match(array<Byte>^ input, bool first)
+        {
+            pin_ptr<Byte> bytes = nullptr;
+            if(input->Length)
+                bytes = &input[0];
+
+            return this->_match((const char*)bytes, input->Length, first);
+        }
+
+
+        bool RegexSet::IsMatch(String^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            RegexInput^ ri = Regex::_convert(input, "input", _options);
+            bool        rv = this->_match(ri->Data, ri->Length, true)->Length > 0;
+            GC::KeepAlive(ri);
+            return rv;
+        }
+
+
+        bool RegexSet::IsMatch(array<Byte>^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            return this->_match(input, true)->Length > 0;
+        }
+
+
+        array<int>^ RegexSet::Match(String^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            RegexInput^ ri = Regex::_convert(input, "input", _options);
+            array<int>^ rv = this->_match(ri->Data, ri->Length, false);
+            GC::KeepAlive(ri);
+            return rv;
+        }
+
+
+        array<int>^ RegexSet::Match(array<Byte>^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            return this->_match(input, false);
+        }
+
+    #pragma endregion
+}
+}
\ No newline at end of file
@@ -0,0 +1,270 @@
+/*
+ *  Re2.Net Copyright  2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#include "Regex.h"
+#include "RegexOptions.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    using namespace System;
+
+    using System::Collections::Generic::IEnumerable;
+
+    using Microsoft::Win32::SafeHandles::SafeHandleZeroOrMinusOneIsInvalid;
+
+    ref class Regex;
+
+    /* The atoms, requirement trees, and Aho-Corasick automaton of a RegexSet. See RegexSet.cpp. */
+    class Prefilter;
+
+
+    /// <summary>
+    ///     Represents an immutable set of regular expressions that are matched against an input together.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///         Each expression is compiled on its own, so the set can grow to thousands of expressions without any one
+    ///         automaton outgrowing its memory budget. When the set is created, the literal strings that a match of each
+    ///         expression must contain (its atoms) are extracted from the pattern, and combined into a requirement such as
+    ///         <c>"error" AND ("disk" OR "volume")</c>. An input is scanned once, with an Aho-Corasick automaton, for all atoms
+    ///         of all expressions, and only the expressions whose requirements are met (the candidates) are run.
+    ///     </para>
+    ///     <para>
+    ///         Atoms are matched without regard to ASCII case, and atoms shorter than three bytes are not used, so there
+    ///         may be more candidates than matches, but never fewer. An expression without any usable atom, such as
+    ///         <c>\d+</c>, is a candidate for every input.
+    ///     </para>
+    ///     <para>
+    ///         All expressions in a set share the same options, and hence the same encoding, so that a string input is
+    ///         converted only once.
+    ///     </para>
+    /// </remarks>
+    public ref class RegexSet sealed
+    {
+        private:
+
+            /* Owns _prefilter. See Regex::RE2Handle. */
+            ref class PrefilterHandle sealed : SafeHandleZeroOrMinusOneIsInvalid
+            {
+                internal:
+
+                    PrefilterHandle(const Prefilter* prefilter);
+
+
+                protected:
+
+                    virtual bool ReleaseHandle() override;
+            };
+
+
+            /*
+             *  _prefilter  : The native prefilter. Code passing it to native code must keep the
+             *                RegexSet alive until the call ends, as with Regex::_re2.
+             *
+             *  _unfiltered : The number of expressions without a requirement.
+             *
+             *  _inputs, _candidates, _matches : Counters, updated with Interlocked.
+             */
+            initonly array<Regex^>^ _regexes;
+            initonly RegexOptions   _options;
+            const Prefilter*        _prefilter;
+            PrefilterHandle^        _handle;
+            initonly int            _unfiltered;
+
+            Int64 _inputs;
+            Int64 _candidates;
+            Int64 _matches;
+
+            array<int>^ _match(const char* data, int size, bool first);
+            array<int>^ _match(array<Byte>^ input, bool first);
+
+
+        public:
+
+            /// <summary>
+            ///     Initializes and compiles a new set of regular expressions.
+            /// </summary>
+            /// <param name="patterns">The regular expression patterns to match.</param>
+            /// <exception cref="System::ArgumentException">
+            ///     A regular expression parsing error occurred.
+            /// </exception>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <para><paramref name="patterns"/> is <c>null</c>.</para>
+            ///     <para>- or -</para>
+            ///     <para>An element of <paramref name="patterns"/> is <c>null</c>.</para>
+            /// </exception>
+            RegexSet(IEnumerable<String^>^ patterns);
+
+
+            /// <summary>
+            ///     Initializes and compiles a new set of regular expressions, with options that modify the patterns.
+            /// </summary>
+            /// <param name="patterns">The regular expression patterns to match.</param>
+            /// <param name="options">A bitwise combination of the enumeration values that modify the regular expressions.</param>
+            /// <exception cref="System::ArgumentException">
+            ///     A regular expression parsing error occurred.
+            /// </exception>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <para><paramref name="patterns"/> is <c>null</c>.</para>
+            ///     <para>- or -</para>
+            ///     <para>An element of <paramref name="patterns"/> is <c>null</c>.</para>
+            /// </exception>
+            /// <exception cref="System::ArgumentOutOfRangeException">
+            ///     <para><paramref name="options"/> contains an invalid flag.</para>
+            ///     <para>- or -</para>
+            ///     <para>A pattern is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+            ///     <para>- or -</para>
+            ///     <para>A pattern is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+            /// </exception>
+            RegexSet(IEnumerable<String^>^ patterns, RegexOptions options);
+
+
+            /// <summary>
+            ///     Gets the number of regular expressions in the set.
+            /// </summary>
+            /// <value>
+            ///     The number of patterns passed into the <c>RegexSet</c> constructor.
+            /// </value>
+            property int Count { int get(); }
+
+
+            /// <summary>
+            ///     Gets the regular expression at the specified index.
+            /// </summary>
+            /// <param name="index">The zero-based index of the pattern passed into the <c>RegexSet</c> constructor.</param>
+            /// <value>
+            ///     The compiled regular expression.
+            /// </value>
+            /// <exception cref="System::IndexOutOfRangeException">
+            ///     <paramref name="index"/> is less than zero or greater than or equal to <see cref="Count"/>.
+            /// </exception>
+            property Regex^ default[int] { Regex^ get(int index); }
+
+
+            /// <summary>
+            ///     Gets the options that were passed into the <c>RegexSet</c> constructor.
+            /// </summary>
+            /// <value>
+            ///     The options shared by every regular expression in the set.
+            /// </value>
+            property RegexOptions Options { RegexOptions get(); }
+
+
+            /// <summary>
+            ///     Gets the number of regular expressions that are run for every input, because no atom could be extracted from
+            ///     their patterns.
+            /// </summary>
+            /// <value>
+            ///     The number of unfiltered regular expressions.
+            /// </value>
+            property int UnfilteredCount { int get(); }
+
+
+            /// <summary>
+            ///     Gets the number of inputs matched against the set since it was created or its counters were reset.
+            /// </summary>
+            property Int64 InputCount { Int64 get(); }
+
+
+            /// <summary>
+            ///     Gets the number of regular expressions run, because their requirements were met, since the set was created or
+            ///     its counters were reset.
+            /// </summary>
+            property Int64 CandidateCount { Int64 get(); }
+
+
+            /// <summary>
+            ///     Gets the number of regular expressions found to match since the set was created or its counters were reset.
+            /// </summary>
+            property Int64 MatchCount { Int64 get(); }
+
+
+            /// <summary>
+            ///     Gets the fraction of regular expressions that were run, out of all that could have been.
+            /// </summary>
+            /// <value>
+            ///     <see cref="CandidateCount"/> divided by the product of <see cref="InputCount"/> and <see cref="Count"/>, or
+            ///     0 if nothing has been matched. The lower the rate, the more work the prefilter saves.
+            /// </value>
+            property double CandidateRate { double get(); }
+
+
+            /// <summary>
+            ///     Sets <see cref="InputCount"/>, <see cref="CandidateCount"/>, and <see cref="MatchCount"/> to zero.
+            /// </summary>
+            void ResetCounters();
+
+
+            /// <summary>
+            ///     Indicates whether any regular expression in the set finds a match in the specified input string.
+            /// </summary>
+            /// <param name="input">The string to search for a match.</param>
+            /// <returns><c>true</c> if a regular expression finds a match; otherwise, <c>false</c>.</returns>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="input"/> is <c>null</c>.
+            /// </exception>
+            /// <exception cref="System::ArgumentOutOfRangeException">
+            ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+            ///     <para>- or -</para>
+            ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+            /// </exception>
+            bool IsMatch(String^ input);
+
+
+            /// <summary>
+            ///     Indicates whether any regular expression in the set finds a match in the specified byte array.
+            /// </summary>
+            /// <param name="input">The byte array to search for a match.</param>
+            /// <returns><c>true</c> if a regular expression finds a match; otherwise, <c>false</c>.</returns>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="input"/> is <c>null</c>.
+            /// </exception>
+            bool IsMatch(array<Byte>^ input);
+
+
+            /// <summary>
+            ///     Finds every regular expression in the set that finds a match in the specified input string.
+            /// </summary>
+            /// <param name="input">The string to search for a match.</param>
+            /// <returns>
+            ///     The indices, in ascending order, of the matching regular expressions. If none match, the array is empty.
+            /// </returns>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="input"/> is <c>null</c>.
+            /// </exception>
+            /// <exception cref="System::ArgumentOutOfRangeException">
+            ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+            ///     <para>- or -</para>
+            ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+            /// </exception>
+            array<int>^ Match(String^ input);
+
+
+            /// <summary>
+            ///     Finds every regular expression in the set that finds a match in the specified byte array.
+            /// </summary>
+            /// <param name="input">The byte array to search for a match.</param>
+            /// <returns>
+            ///     The indices, in ascending order, of the matching regular expressions. If none match, the array is empty.
+            /// </returns>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="input"/> is <c>null</c>.
+            /// </exception>
+            array<int>^ Match(array<Byte>^ input);
+
+
+            /// <summary>
+            ///     Releases the compiled prefilter. The regular expressions in the set are not disposed.
+            /// </summary>
+            ~RegexSet();
+    };
+}
+}
\ No newline at end of file
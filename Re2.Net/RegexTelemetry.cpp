@@ -0,0 +1,233 @@
+/*
+ *  Re2.Net Copyright  2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#include "RegexTelemetry.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    using namespace System;
+
+    using System::Diagnostics::Stopwatch;
+    using System::Diagnostics::Tracing::EventCommand;
+    using System::Globalization::CultureInfo;
+    using System::Globalization::NumberStyles;
+    using System::Threading::Interlocked;
+    using System::Threading::Monitor;
+    using System::Threading::Timeout;
+    using System::Threading::TimerCallback;
+
+
+    #pragma region RegexTelemetry
+
+        RegexTelemetry::RegexTelemetry(String^ pattern)
+            : _pattern(pattern)
+        {
+            RegexEventSource::Log->_register(this);
+        }
+
+
+        Int64 RegexTelemetry::_nanoseconds(Int64 ticks)
+        {
+            /* Stopwatch ticks are in units of 1 / Frequency seconds, not TimeSpan's 100 ns. */
+            return static_cast<Int64>(ticks * (1e9 / Stopwatch::Frequency));
+        }
+
+
+        void RegexTelemetry::_searched(Int64 bytes, bool matched, Int64 ticks)
+        {
+            Interlocked::Increment(_calls);
+            Interlocked::Add(_bytes, bytes);
+            if(matched)
+                Interlocked::Increment(_matches);
+            Interlocked::Add(_searchTicks, ticks);
+        }
+
+
+        void RegexTelemetry::_converted(Int64 ticks)
+        {
+            Interlocked::Add(_conversionTicks, ticks);
+        }
+
+
+        void RegexTelemetry::_created(Int64 positionTicks, Int64 allocationTicks)
+        {
+            Interlocked::Add(_positionTicks, positionTicks);
+            Interlocked::Add(_allocationTicks, allocationTicks);
+        }
+
+
+        String^ RegexTelemetry::Pattern::get()
+        {
+            return _pattern;
+        }
+
+
+        Int64 RegexTelemetry::Calls::get()
+        {
+            return Interlocked::Read(_calls);
+        }
+
+
+        Int64 RegexTelemetry::BytesScanned::get()
+        {
+            return Interlocked::Read(_bytes);
+        }
+
+
+        Int64 RegexTelemetry::Matches::get()
+        {
+            return Interlocked::Read(_matches);
+        }
+
+
+        Int64 RegexTelemetry::ConversionNanoseconds::get()
+        {
+            return _nanoseconds(Interlocked::Read(_conversionTicks));
+        }
+
+
+        Int64 RegexTelemetry::SearchNanoseconds::get()
+        {
+            return _nanoseconds(Interlocked::Read(_searchTicks));
+        }
+
+
+        Int64 RegexTelemetry::PositionNanoseconds::get()
+        {
+            return _nanoseconds(Interlocked::Read(_positionTicks));
+        }
+
+
+        Int64 RegexTelemetry::AllocationNanoseconds::get()
+        {
+            return _nanoseconds(Interlocked::Read(_allocationTicks));
+        }
+
+
+        void RegexTelemetry::Reset()
+        {
+            Interlocked::Exchange(_calls, 0);
+            Interlocked::Exchange(_bytes, 0);
+            Interlocked::Exchange(_matches, 0);
+            Interlocked::Exchange(_conversionTicks, 0);
+            Interlocked::Exchange(_searchTicks, 0);
+            Interlocked::Exchange(_positionTicks, 0);
+            Interlocked::Exchange(_allocationTicks, 0);
+        }
+
+    #pragma endregion
+
+
+    #pragma region RegexEventSource
+
+        RegexEventSource::RegexEventSource()
+        {
+            _telemetry = gcnew List<WeakReference^>();
+            _sweepAt   = 64;
+            _timer     = gcnew Timer(gcnew TimerCallback(this, &RegexEventSource::_publish), nullptr, Timeout::Infinite, Timeout::Infinite);
+        }
+
+
+        void RegexEventSource::_register(RegexTelemetry^ telemetry)
+        {
+            Monitor::Enter(_telemetry);
+            try
+            {
+                if(_telemetry->Count >= _sweepAt)
+                {
+                    _sweep();
+                    _sweepAt = Math::Max(64, _telemetry->Count * 2);
+                }
+
+                _telemetry->Add(gcnew WeakReference(telemetry));
+            }
+            finally
+            {
+                Monitor::Exit(_telemetry);
+            }
+        }
+
+
+        void RegexEventSource::_sweep()
+        {
+            /* Compacted in place, rather than with RemoveAt, so that a sweep is linear. */
+            int live = 0;
+            for(int i = 0; i < _telemetry->Count; i++)
+                if(_telemetry[i]->IsAlive)
+                    _telemetry[live++] = _telemetry[i];
+
+            _telemetry->RemoveRange(live, _telemetry->Count - live);
+        }
+
+
+        void RegexEventSource::_publish(Object^ state)
+        {
+            if(!this->IsEnabled())
+                return;
+
+            List<RegexTelemetry^>^ live = gcnew List<RegexTelemetry^>();
+
+            Monitor::Enter(_telemetry);
+            try
+            {
+                for(int i = _telemetry->Count - 1; i >= 0; i--)
+                {
+                    RegexTelemetry^ telemetry = safe_cast<RegexTelemetry^>(_telemetry[i]->Target);
+                    if(telemetry)
+                        live->Add(telemetry);
+                    else
+                        _telemetry->RemoveAt(i);
+                }
+            }
+            finally
+            {
+                Monitor::Exit(_telemetry);
+            }
+
+            /* Written outside the lock, so that new Regex objects aren't held up by listeners. */
+            for each(RegexTelemetry^ telemetry in live)
+                this->RegexCounters(telemetry->Pattern, telemetry->Calls, telemetry->BytesScanned, telemetry->Matches,
+                                    telemetry->ConversionNanoseconds, telemetry->SearchNanoseconds,
+                                    telemetry->PositionNanoseconds, telemetry->AllocationNanoseconds);
+        }
+
+
+        void RegexEventSource::OnEventCommand(EventCommandEventArgs^ command)
+        {
+            if(command->Command == EventCommand::Disable)
+            {
+                _timer->Change(Timeout::Infinite, Timeout::Infinite);
+                return;
+            }
+
+            /* The argument EventCounters are enabled with, so that the same listener settings work. */
+            String^ interval;
+            double  seconds;
+            if(command->Command == EventCommand::Enable && command->Arguments
+               && command->Arguments->TryGetValue("EventCounterIntervalSec", interval)
+               && Double::TryParse(interval, NumberStyles::Float, CultureInfo::InvariantCulture, seconds) && seconds > 0)
+            {
+                TimeSpan period = TimeSpan::FromSeconds(seconds);
+                _timer->Change(period, period);
+            }
+        }
+
+
+        void RegexEventSource::RegexCounters(String^ pattern, Int64 calls, Int64 bytesScanned, Int64 matches, Int64 conversionNanoseconds,
+                                             Int64 searchNanoseconds, Int64 positionNanoseconds, Int64 allocationNanoseconds)
+        {
+            this->WriteEvent(1, gcnew array<Object^> { pattern, calls, bytesScanned, matches, conversionNanoseconds,
+                                                       searchNanoseconds, positionNanoseconds, allocationNanoseconds });
+        }
+
+    #pragma endregion
+}
+}
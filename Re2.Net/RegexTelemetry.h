@@ -0,0 +1,233 @@
+/*
+ *  Re2.Net Copyright  2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#include "RegexOptions.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    using namespace System;
+
+    using System::Collections::Generic::List;
+    using System::Diagnostics::Tracing::EventCommandEventArgs;
+    using System::Diagnostics::Tracing::EventSource;
+    using System::Threading::Timer;
+
+
+    /// <summary>
+    ///     Counts the calls made to a <c>Regex</c>, and the time they spend in each phase of matching.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///         Counters are only kept for a <c>Regex</c> created with <see cref="RegexOptions::Telemetry"/>. They are updated
+    ///         atomically, so they can be read while other threads match, although a set of counters read one after another
+    ///         may not add up exactly.
+    ///     </para>
+    ///     <para>
+    ///         The counters of every live <c>RegexTelemetry</c> are also written by the <c>Re2-Net</c> event source. See
+    ///         <see cref="RegexEventSource"/>.
+    ///     </para>
+    /// </remarks>
+    public ref class RegexTelemetry sealed
+    {
+        private:
+
+            /*
+             *  _pattern : The pattern of the Regex, to tell events apart.
+             *
+             *  _calls, _bytes, _matches : Searches run, input bytes they covered, and searches that matched.
+             *
+             *  _conversionTicks : Stopwatch ticks spent converting string inputs, and their indices,
+             *                     into the encoding of the Regex.
+             *
+             *  _searchTicks     : Ticks spent in RE2 and the native searchers that stand in for it.
+             *
+             *  _positionTicks   : Ticks spent turning UTF-8 offsets of matches back into string indices.
+             *
+             *  _allocationTicks : Ticks spent creating Match and Group objects, not counting _positionTicks.
+             */
+            initonly String^ _pattern;
+
+            Int64 _calls;
+            Int64 _bytes;
+            Int64 _matches;
+            Int64 _conversionTicks;
+            Int64 _searchTicks;
+            Int64 _positionTicks;
+            Int64 _allocationTicks;
+
+            static Int64 _nanoseconds(Int64 ticks);
+
+
+        internal:
+
+            RegexTelemetry(String^ pattern);
+
+            void _searched(Int64 bytes, bool matched, Int64 ticks);
+            void _converted(Int64 ticks);
+            void _created(Int64 positionTicks, Int64 allocationTicks);
+
+
+        public:
+
+            /// <summary>
+            ///     Gets the pattern of the <c>Regex</c> the counters belong to.
+            /// </summary>
+            property String^ Pattern { String^ get(); }
+
+
+            /// <summary>
+            ///     Gets the number of searches run, including every match found by <c>Matches</c>.
+            /// </summary>
+            property Int64 Calls { Int64 get(); }
+
+
+            /// <summary>
+            ///     Gets the number of input bytes the searches covered, in the encoding of the <c>Regex</c>.
+            /// </summary>
+            /// <remarks>
+            ///     A search that stops at its first match is still counted up to the end of its input. A literal found without
+            ///     converting a string counts two bytes per character.
+            /// </remarks>
+            property Int64 BytesScanned { Int64 get(); }
+
+
+            /// <summary>
+            ///     Gets the number of searches that found a match.
+            /// </summary>
+            property Int64 Matches { Int64 get(); }
+
+
+            /// <summary>
+            ///     Gets the time spent converting string inputs, and the indices into them, to UTF-8, Latin-1, or ASCII.
+            /// </summary>
+            /// <value>
+            ///     The cumulative time, in nanoseconds.
+            /// </value>
+            /// <remarks>
+            ///     A string given to a <c>RegexCursor</c> or a <c>RegexSet</c> is converted once for all the <c>Regex</c> objects that
+            ///     search it, so its conversion isn't counted here.
+            /// </remarks>
+            property Int64 ConversionNanoseconds { Int64 get(); }
+
+
+            /// <summary>
+            ///     Gets the time spent searching, in RE2 or in the native searchers that stand in for it.
+            /// </summary>
+            /// <value>
+            ///     The cumulative time, in nanoseconds.
+            /// </value>
+            property Int64 SearchNanoseconds { Int64 get(); }
+
+
+            /// <summary>
+            ///     Gets the time spent translating the UTF-8 offsets of matches and groups back into string indices.
+            /// </summary>
+            /// <value>
+            ///     The cumulative time, in nanoseconds. Always 0 for byte array inputs and single-byte encodings.
+            /// </value>
+            property Int64 PositionNanoseconds { Int64 get(); }
+
+
+            /// <summary>
+            ///     Gets the time spent creating <c>Match</c> and <c>Group</c> objects, other than translating positions.
+            /// </summary>
+            /// <value>
+            ///     The cumulative time, in nanoseconds.
+            /// </value>
+            property Int64 AllocationNanoseconds { Int64 get(); }
+
+
+            /// <summary>
+            ///     Sets every counter to zero.
+            /// </summary>
+            void Reset();
+    };
+
+
+    /// <summary>
+    ///     Writes the counters of every <c>Regex</c> created with <see cref="RegexOptions::Telemetry"/> as events of the
+    ///     <c>Re2-Net</c> event source.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///         .NET Framework 4.5 has no <c>EventCounter</c>, so counters are published the way EventCounters are consumed:
+    ///         when a listener enables the source with an <c>EventCounterIntervalSec</c> argument, a <c>RegexCounters</c>
+    ///         event is written for each live <c>RegexTelemetry</c> every that many seconds. Without the argument, nothing is
+    ///         written.
+    ///     </para>
+    /// </remarks>
+    [System::Diagnostics::Tracing::EventSourceAttribute(Name = "Re2-Net")]
+    public ref class RegexEventSource sealed : EventSource
+    {
+        private:
+
+            /*
+             *  _telemetry : Weak references to every RegexTelemetry created, so that the source doesn't
+             *               keep their Regex objects alive. Dead ones are dropped as events are written,
+             *               and whenever the list reaches _sweepAt.
+             *
+             *  _sweepAt   : The count at which _register next drops dead references. Twice the live
+             *               count after each sweep, so that the list stays in proportion to the live
+             *               Regex objects even with no listener, at amortized constant cost.
+             *
+             *  _timer     : Writes the events. Stopped until a listener asks for an interval.
+             */
+            List<WeakReference^>^ _telemetry;
+            int                   _sweepAt;
+            Timer^                _timer;
+
+            RegexEventSource();
+
+            /* Drops dead references. Called with the lock on _telemetry held. */
+            [System::Diagnostics::Tracing::NonEventAttribute]
+            void _sweep();
+
+            /* Every method of an event source is taken for an event unless it says otherwise. */
+            [System::Diagnostics::Tracing::NonEventAttribute]
+            void _publish(Object^ state);
+
+
+        internal:
+
+            [System::Diagnostics::Tracing::NonEventAttribute]
+            void _register(RegexTelemetry^ telemetry);
+
+
+        protected:
+
+            virtual void OnEventCommand(EventCommandEventArgs^ command) override;
+
+
+        public:
+
+            /// <summary>
+            ///     Gets the only instance of the event source.
+            /// </summary>
+            static initonly RegexEventSource^ Log = gcnew RegexEventSource();
+
+
+            /// <summary>
+            ///     Writes the counters of one <c>Regex</c>. Called by the event source itself, on its own interval.
+            /// </summary>
+            /// <param name="pattern">The pattern of the <c>Regex</c>.</param>
+            /// <param name="calls">See <see cref="RegexTelemetry::Calls"/>.</param>
+            /// <param name="bytesScanned">See <see cref="RegexTelemetry::BytesScanned"/>.</param>
+            /// <param name="matches">See <see cref="RegexTelemetry::Matches"/>.</param>
+            /// <param name="conversionNanoseconds">See <see cref="RegexTelemetry::ConversionNanoseconds"/>.</param>
+            /// <param name="searchNanoseconds">See <see cref="RegexTelemetry::SearchNanoseconds"/>.</param>
+            /// <param name="positionNanoseconds">See <see cref="RegexTelemetry::PositionNanoseconds"/>.</param>
+            /// <param name="allocationNanoseconds">See <see cref="RegexTelemetry::AllocationNanoseconds"/>.</param>
+            [System::Diagnostics::Tracing::EventAttribute(1, Level = System::Diagnostics::Tracing::EventLevel::Informational)]
+            void RegexCounters(String^ pattern, Int64 calls, Int64 bytesScanned, Int64 matches, Int64 conversionNanoseconds,
+                               Int64 searchNanoseconds, Int64 positionNanoseconds, Int64 allocationNanoseconds);
+    };
+}
+}
@@ -0,0 +1,232 @@
+/*
+ *  Re2.Net Copyright  2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#pragma managed(push, off)
+    #include <string.h>
+    #include <vector>
+#pragma managed(pop)
+
+
+namespace Re2
+{
+namespace Net
+{
+    #pragma managed(push, off)
+
+    /*
+     *  A bit-parallel (Shift-And) matcher for patterns that are a sequence of byte classes, each of
+     *  which may be optional or repeat, e.g. "a[^x]{20}b" as 'a', 20 times [^x], and 'b'. Bit j of the
+     *  state is set if the input so far ends with a match of positions 0 through j, so one step of the
+     *  search is a shift, an OR, and an AND for up to 63 positions. Bounded repetitions that make RE2's
+     *  DFA states multiply, like the {20} above, cost nothing extra.
+     *
+     *  Skipping optional positions is done for every run of them at once: subtracting the first bit of
+     *  a run from its ready bits (plus its last bit) sets every bit below the lowest ready one, and the
+     *  XOR and complement turn that into every bit above it.
+     */
+    class ShiftAnd
+    {
+        public:
+
+            /* Bit 63 is left free so that the position after the last can be marked ready. */
+            static const int MAX_POSITIONS = 63;
+
+            struct Position
+            {
+                bool bytes[256];
+                bool optional;
+                bool loop;
+            };
+
+
+        private:
+
+            /*
+             *  _masks   : For each byte, the positions it matches.
+             *
+             *  _loops   : Positions that can match again right after themselves.
+             *
+             *  _skips, _firsts, _lasts : Optional positions, and the first and last of each run of them.
+             *
+             *  _accepts : Positions after which every remaining position is optional.
+             *
+             *  _asciiOnly : Set in UTF-8 mode, where a class can match a multibyte character. Only ASCII
+             *               input, in which every character is one byte, can be searched.
+             *
+             *  _maxLength : The most bytes a match can span, or -1 if a position loops.
+             */
+            unsigned long long _masks[256];
+            unsigned long long _loops;
+            unsigned long long _skips;
+            unsigned long long _firsts;
+            unsigned long long _lasts;
+            unsigned long long _accepts;
+            bool               _anchorStart;
+            bool               _anchorEnd;
+            bool               _lineAnchors;
+            bool               _asciiOnly;
+            int                _maxLength;
+
+
+            /* The positions that can match the next byte. */
+            unsigned long long Ready(unsigned long long state, bool start) const
+            {
+                unsigned long long ready = state << 1 | (start ? 1 : 0);
+                unsigned long long runs  = ready & _skips;
+                unsigned long long fill  = _skips & ~(((runs | _lasts) - _firsts) ^ (runs | _lasts));
+                return ready | fill | ((runs | fill) & _lasts) << 1;
+            }
+
+
+            unsigned long long Step(unsigned long long state, bool start, unsigned char c) const
+            {
+                return (Ready(state, start) | (state & _loops)) & _masks[c];
+            }
+
+
+            /* '^' and '$' match at the ends of the text, and next to '\n' if they match at lines. */
+            bool CanStart(const char* data, int pos) const
+            {
+                return !_anchorStart || pos == 0 || (_lineAnchors && data[pos - 1] == '\n');
+            }
+
+
+            bool CanEnd(const char* data, int size, int pos) const
+            {
+                return !_anchorEnd || pos == size || (_lineAnchors && data[pos] == '\n');
+            }
+
+
+            /* As Search, but for a match starting at start. */
+            int MatchAt(const char* data, int size, int start, int endIndex, bool anchorBoth) const
+            {
+                if(!CanStart(data, start))
+                    return 0;
+
+                unsigned long long state = 0;
+                for(int pos = start; pos < endIndex; ++pos)
+                {
+                    unsigned char c = static_cast<unsigned char>(data[pos]);
+                    if(_asciiOnly && c >= 0x80)
+                        return -1;
+
+                    state = Step(state, pos == start, c);
+                    if(!state)
+                        return 0;
+                    if((state & _accepts) && (!anchorBoth || pos + 1 == endIndex) && CanEnd(data, size, pos + 1))
+                        return 1;
+                }
+                return 0;
+            }
+
+
+        public:
+
+            /* positions must not all be optional; a pattern that can match nothing is left to RE2. */
+            ShiftAnd(const std::vector<Position>& positions, bool anchorStart, bool anchorEnd, bool lineAnchors, bool asciiOnly)
+                : _loops(0), _skips(0), _firsts(0), _lasts(0), _accepts(0),
+                  _anchorStart(anchorStart), _anchorEnd(anchorEnd), _lineAnchors(lineAnchors), _asciiOnly(asciiOnly),
+                  _maxLength(static_cast<int>(positions.size()))
+            {
+                memset(_masks, 0, sizeof(_masks));
+
+                int count = static_cast<int>(positions.size());
+                for(int j = 0; j < count; ++j)
+                {
+                    unsigned long long bit = 1ULL << j;
+                    for(int c = 0; c < 256; ++c)
+                        if(positions[j].bytes[c])
+                            _masks[c] |= bit;
+
+                    if(positions[j].loop)
+                    {
+                        _loops    |= bit;
+                        _maxLength = -1;
+                    }
+                    if(positions[j].optional)
+                    {
+                        _skips |= bit;
+                        if(!j || !positions[j - 1].optional)
+                            _firsts |= bit;
+                        if(j == count - 1 || !positions[j + 1].optional)
+                            _lasts |= bit;
+                    }
+                }
+
+                for(int j = count - 1; j >= 0; --j)
+                {
+                    _accepts |= 1ULL << j;
+                    if(!positions[j].optional)
+                        break;
+                }
+            }
+
+
+            /*
+             *  Searches data[startIndex, endIndex). anchorStart and anchorBoth are RE2::ANCHOR_START and
+             *  RE2::ANCHOR_BOTH. Returns 1 if there's a match, 0 if there isn't, and -1 if the input can't
+             *  be searched (see _asciiOnly) and RE2 has to.
+             *
+             *  If matchStart isn't nullptr, it's set to where the leftmost match starts, or to -1 if that
+             *  would take more than one pass (see _maxLength). Where it ends depends on the priorities of
+             *  the repetitions, which is left to RE2, anchored there.
+             */
+            int Search(const char* data, int size, int startIndex, int endIndex, bool anchorStart, bool anchorBoth, int* matchStart) const
+            {
+                int                end   = -1;
+                unsigned long long state = 0;
+
+                for(int pos = startIndex; pos < endIndex; ++pos)
+                {
+                    unsigned char c = static_cast<unsigned char>(data[pos]);
+                    if(_asciiOnly && c >= 0x80)
+                        return -1;
+
+                    bool start = (!anchorStart || pos == startIndex) && CanStart(data, pos);
+                    if(!start && !state && (anchorStart || (_anchorStart && !_lineAnchors)))
+                        return 0;
+
+                    state = Step(state, start, c);
+                    if((state & _accepts) && (!anchorBoth || pos + 1 == endIndex) && CanEnd(data, size, pos + 1))
+                    {
+                        end = pos + 1;
+                        break;
+                    }
+                }
+
+                if(end < 0)
+                    return 0;
+                if(!matchStart)
+                    return 1;
+
+                /*
+                 *  No match ends before end, so none starts more than _maxLength bytes before it. The
+                 *  first start in that span from which a match can be completed is the leftmost.
+                 */
+                *matchStart = anchorStart ? startIndex : -1;
+                if(!anchorStart && _maxLength >= 0)
+                {
+                    for(int start = end - _maxLength > startIndex ? end - _maxLength : startIndex; start < end; ++start)
+                    {
+                        int found = MatchAt(data, size, start, endIndex, anchorBoth);
+                        if(found)
+                        {
+                            if(found < 0)
+                                return -1;
+                            *matchStart = start;
+                            break;
+                        }
+                    }
+                }
+                return 1;
+            }
+    };
+
+    #pragma managed(pop)
+}
+}
\ No newline at end of file
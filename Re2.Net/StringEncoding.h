@@ -0,0 +1,183 @@
+/*
+ *  Re2.Net Copyright  2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+
+/*
+ *  The kernels that convert .NET strings to RE2's encodings, and translate offsets between
+ *  them. They're plain C++, without any CLR types, so that Re2.Net.Benchmark can build them
+ *  on their own. wchar_t must be a UTF-16 code unit, which takes -fshort-wchar outside MSVC.
+ */
+namespace Re2
+{
+namespace Net
+{
+    #pragma managed(push, off)
+
+    /* 2 bytes of UTF-16 can require up to 3 bytes of UTF-8, so utf8 must hold length * 3 bytes. */
+    static int stringToUTF8(const wchar_t* chars, int length, char* utf8)
+    {
+        int size = 0;
+        for(int i = 0; i < length; ++i)
+        {
+            wchar_t u = chars[i] - 0xd800;
+            int     c;
+
+            if(!((unsigned)u <= 0xdfff - 0xd800))
+                c = chars[i];
+            else
+                c = u * 0x400 + chars[++i] + 0x2400;
+
+            #pragma warning(disable:4244) 
+            if(c < 0x0080)
+            {
+                utf8[size++] = static_cast<char>(c);
+            }
+            else if(c < 0x0800)
+            {
+                utf8[size++] = 0xc0 | (c >> 6);
+                utf8[size++] = 0x80 | (c & 0x3f);
+            }
+            else if(c < 0x10000)
+            {
+                utf8[size++] = 0xe0 | (c >> 12);
+                utf8[size++] = 0x80 | ((c >> 6) & 0x3f);
+                utf8[size++] = 0x80 | (c & 0x3f);
+            }
+            else
+            {
+                utf8[size++] = 0xf0 | (c >> 18);
+                utf8[size++] = 0x80 | ((c >> 12) & 0x3f);
+                utf8[size++] = 0x80 | ((c >> 6) & 0x3f);
+                utf8[size++] = 0x80 | (c & 0x3f);
+            }
+            #pragma warning(default:4244)
+        }
+
+        return size;
+    }
+
+
+    /*
+     *  Returns whether chars holds a surrogate that isn't half of a pair. stringToUTF8 doesn't
+     *  replace these: it pairs a lone surrogate with the char after it, and that char is lost.
+     */
+    static bool hasLoneSurrogate(const wchar_t* chars, int length)
+    {
+        for(int i = 0; i < length; ++i)
+        {
+            if(chars[i] < 0xd800 || chars[i] > 0xdfff)
+                continue;
+            if(chars[i] > 0xdbff || i + 1 == length || chars[i + 1] < 0xdc00 || chars[i + 1] > 0xdfff)
+                return true;
+            ++i;
+        }
+        return false;
+    }
+
+
+    /*
+     *  Narrows UTF-16 to a single-byte encoding. max is 0x7f for ASCII or 0xff for Latin-1.
+     *  Out-of-range chars are OR'ed together rather than tested one by one, which keeps the
+     *  loop free of branches; the caller learns about them from the return value.
+     */
+    static bool stringToSingleByte(const wchar_t* chars, int length, char* bytes, wchar_t max)
+    {
+        wchar_t overflow = 0;
+        for(int i = 0; i < length; ++i)
+        {
+            overflow |= chars[i];
+            bytes[i]  = static_cast<char>(chars[i]);
+        }
+        return !(overflow & ~max);
+    }
+
+
+    /*
+     *  Counts the number of chars in a UTF-8 sequence. This is necessary because the
+     *  Index of a Capture, Group, or Match is reported in terms of the entire input,
+     *  regardless of startIndex or length.
+     */
+    static int StrToCharPos(const char* input, int utf16_length)
+    {
+        int rv = 0;
+        for(int i = 0; i < utf16_length; ++i)
+        {
+            /* 0b1xxxxxxx marks the start of a UTF-8 sequence. */
+            if((input[rv] & 0x80))
+            {
+                if((input[rv] & 0xe0) == 0xc0)
+                {
+                    rv += 2;
+                }
+                else if((input[rv] & 0xf0) == 0xe0)
+                {
+                    rv += 3;
+                }
+                else if((input[rv] & 0xf8) == 0xf0)
+                {
+                    rv += 4;
+                    /*
+                     *  .NET strings are counted in UTF-16 code units, not Unicode code
+                     *  points. The two differ only outside the BMP, i.e. this case.
+                     *
+                     *  Since StrToCharPos goes by .NET string length, i is double-
+                     *  incremented to include both UTF-16 surrogates.
+                     */
+                    i++;
+                }
+            }
+            else rv++;
+        }
+        return rv;
+    }
+    
+
+    /*
+     *  Counts the number of UTF-8 characters in a char sequence. This is necessary
+     *  because the Index of a Capture, Group, or Match is reported in terms of the
+     *  entire input, regardless of startIndex or length.
+     */
+    static int CharToStrPos(const char* input, int char_length)
+    {
+        int rv = 0;
+        for(int i = 0; i < char_length; ++rv)
+        {
+            /* 0b1xxxxxxx marks the start of a UTF-8 sequence. */
+            if((input[i] & 0x80))
+            {
+                if((input[i] & 0xe0) == 0xc0)
+                {
+                    i += 2;
+                }
+                else if((input[i] & 0xf0) == 0xe0)
+                {
+                    i += 3;
+                }
+                else if((input[i] & 0xf8) == 0xf0)
+                {
+                    i += 4;
+                    /*
+                     *  .NET strings are counted in UTF-16 code units, not Unicode code
+                     *  points. The two differ only outside the BMP, i.e. this case.
+                     *
+                     *  Since CharToStrPos goes by C string length, rv is double-
+                     *  incremented to include both UTF-16 surrogates.
+                     */
+                    rv++;
+                }
+                // else ...
+                /* Input must be valid UTF-8 or i never increments. */
+            }
+            else i++;
+        }
+        return rv;
+    }
+
+    #pragma managed(pop)
+}
+}